@@ -4,9 +4,12 @@
 
 #include <iostream>
 #include <string>
-#include <cassert>
-#include <iomanip>
 #include <complex>
+#include <tuple>
+#include <vector>
+
+#include "RadixSort.h"
+#include "RecordSchema.h"
 
 namespace nspace
 {
@@ -18,49 +21,31 @@ namespace nspace
         std::string key3;
     };
 
+    // (:key1 017:key2 #c(1.0 -2.0):key3 "text":), sorted by key1, |key2|
+    // and the length of key3.
+    constexpr auto recordSchema() {
+        using namespace common;
+        return makeSchema(
+            field(":key1", &DataStructure::key1, IntegerLiteral<8, Chars<'0'>>()),
+            field(":key2", &DataStructure::key2, ComplexLiteral(), ByMagnitude()),
+            field(":key3", &DataStructure::key3, QuotedString(), ByLength()));
+    }
+
+    // Fields comparator orders by, compared lexicographically.
+    using SortKey = std::tuple<unsigned long long, double, std::size_t>;
+
+    SortKey makeSortKey(const DataStructure& data);
+    // The same key as unsigned integers in the same order, for radixSort;
+    // |key2| is never negative or NaN, so its bits order it. The index is
+    // 32-bit, as radixSort takes at most 2^32 records.
+    common::RadixItem<3> makeRadixItem(const DataStructure& data, std::uint32_t index);
     bool comparator(const DataStructure& struct1, const DataStructure& struct2);
 
-    struct DelimiterIO
-    {
-        char exp;
-    };
-
-    struct OctalUnsignedLongLongIO
-    {
-        unsigned long long& ref;
-    };
-
-    struct ComplexDoubleIO {
-        std::complex<double>& ref;
-    };
-
-    struct StringIO
-    {
-        std::string& ref;
-    };
-
-    //
-
-    // scope guard       
-    class iofmtguard
-    {
-    public:
-        iofmtguard(std::basic_ios< char >& s);
-        ~iofmtguard();
-    private:
-        std::basic_ios< char >& s_;
-        std::streamsize width_;
-        char fill_;
-        std::streamsize precision_;
-        std::basic_ios< char >::fmtflags fmt_;
-    };
-
-    std::istream& operator>>(std::istream& in, DelimiterIO&& dest);
-    std::istream& operator>>(std::istream& in, OctalUnsignedLongLongIO&& dest);
-    std::istream& operator>>(std::istream& in, ComplexDoubleIO&& dest);
-    std::istream& operator>>(std::istream& in, StringIO&& dest);
+    // The records of the text, read like
+    //     while (!in.eof()) { copy records; on failure clear and skip the line }
+    // over a stream would.
+    std::vector<DataStructure> readRecords(const char* begin, const char* end);
 
-    std::istream& operator>>(std::istream& in, DataStructure& dest);
     std::ostream& operator<<(std::ostream& out, const DataStructure& dest);
 }
 
@@ -1,31 +1,32 @@
 #include <iostream>
 #include "Data_Structure.h"
-#include <algorithm>
-#include <cstdio>
-#include <fstream>
 #include <vector>
-#include <iterator>
-#include <limits>
 
-int main() {
+#include <unistd.h>
+
+#include "InputBuffer.h"
+#include "PhaseStats.h"
+#include "RadixSort.h"
+
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+    common::PhaseStats stats(argc, argv);
+    stats.start("parse");
     using nspace::DataStructure;
-    std::vector<DataStructure> data;
-    while (!std::cin.eof()) {
-        std::copy(
-            std::istream_iterator< DataStructure >(std::cin),
-            std::istream_iterator< DataStructure >(),
-            std::back_inserter(data)
-        );
-        if (!std::cin) {
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
+    const common::InputBuffer input(STDIN_FILENO);
+    std::vector<DataStructure> data = nspace::readRecords(input.data(),
+        input.data() + input.size());
+    stats.start("sort");
+    std::vector<common::RadixItem<3>> order(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        order[i] = nspace::makeRadixItem(data[i], static_cast<std::uint32_t>(i));
+    }
+    common::radixSort(order);
+    stats.start("print");
+    for (const auto& item : order) {
+        std::cout << data[item.index] << '\n';
     }
-    std::sort(std::begin(data), std::end(data), nspace::comparator);
-    std::copy(
-        std::begin(data),
-        std::end(data),
-        std::ostream_iterator< DataStructure >(std::cout, "\n")
-    );
+    std::cout.flush();
+    stats.finish();
     return 0;
 }
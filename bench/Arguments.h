@@ -0,0 +1,75 @@
+#ifndef BENCH_ARGUMENTS_H
+#define BENCH_ARGUMENTS_H
+
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    // "--name value" command-line options; a name may repeat.
+    class Arguments
+    {
+    public:
+        Arguments(int argc, char* argv[])
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string name = argv[i];
+                if (name.compare(0, 2, "--") != 0 || i + 1 == argc)
+                {
+                    throw std::invalid_argument("expected --name value, got " + name);
+                }
+                values_[name.substr(2)].push_back(argv[++i]);
+            }
+        }
+
+        std::string get(const std::string& name, const std::string& fallback) const
+        {
+            auto it = values_.find(name);
+            return it == values_.end() ? fallback : it->second.back();
+        }
+
+        long long getInt(const std::string& name, long long fallback) const
+        {
+            auto it = values_.find(name);
+            return it == values_.end() ? fallback : std::stoll(it->second.back());
+        }
+
+        double getDouble(const std::string& name, double fallback) const
+        {
+            auto it = values_.find(name);
+            return it == values_.end() ? fallback : std::stod(it->second.back());
+        }
+
+        std::vector< std::string > getAll(const std::string& name) const
+        {
+            auto it = values_.find(name);
+            return it == values_.end() ? std::vector< std::string >() : it->second;
+        }
+
+    private:
+        std::map< std::string, std::vector< std::string > > values_;
+    };
+
+    inline std::vector< std::string > splitList(const std::string& list)
+    {
+        std::vector< std::string > items;
+        std::string::size_type start = 0;
+        while (start <= list.size())
+        {
+            std::string::size_type end = list.find(',', start);
+            end = end == std::string::npos ? list.size() : end;
+            if (end > start)
+            {
+                items.push_back(list.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return items;
+    }
+}
+
+#endif
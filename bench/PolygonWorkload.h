@@ -0,0 +1,239 @@
+#ifndef BENCH_POLYGON_WORKLOAD_H
+#define BENCH_POLYGON_WORKLOAD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Arguments.h"
+#include "Random.h"
+
+namespace bench
+{
+    using Polygon = std::vector< std::pair< int, int > >;
+
+    struct PolygonOptions
+    {
+        std::size_t count = 10000;
+        int minVertexes = 3;
+        int maxVertexes = 8;
+        // "uniform" picks vertex counts evenly, "small" halves the odds for every extra vertex.
+        std::string vertexDistribution = "uniform";
+        int coordinateRange = 100;
+        double invalidRatio = 0.05;
+        double duplicateRatio = 0.1;
+    };
+
+    struct CommandOptions
+    {
+        std::vector< std::string > types = { "AREA", "COUNT", "MAX", "MIN" };
+        std::size_t perType = 100;
+        double invalidRatio = 0.0;
+    };
+
+    inline PolygonOptions polygonOptionsFrom(const Arguments& args)
+    {
+        PolygonOptions options;
+        options.count = args.getInt("polygons", options.count);
+        options.minVertexes = args.getInt("min-vertexes", options.minVertexes);
+        options.maxVertexes = args.getInt("max-vertexes", options.maxVertexes);
+        options.vertexDistribution = args.get("vertex-distribution", options.vertexDistribution);
+        options.coordinateRange = args.getInt("coordinate-range", options.coordinateRange);
+        options.invalidRatio = args.getDouble("invalid-ratio", options.invalidRatio);
+        options.duplicateRatio = args.getDouble("duplicate-ratio", options.duplicateRatio);
+        return options;
+    }
+
+    inline CommandOptions commandOptionsFrom(const Arguments& args)
+    {
+        CommandOptions options;
+        if (!args.get("command-types", "").empty())
+        {
+            options.types = splitList(args.get("command-types", ""));
+        }
+        options.perType = args.getInt("commands-per-type", options.perType);
+        options.invalidRatio = args.getDouble("invalid-command-ratio", options.invalidRatio);
+        return options;
+    }
+
+    inline std::string formatPolygon(const Polygon& polygon)
+    {
+        std::ostringstream out;
+        out << polygon.size();
+        for (const auto& point : polygon)
+        {
+            out << " (" << point.first << ';' << point.second << ')';
+        }
+        return out.str();
+    }
+
+    inline int randomVertexCount(Random& random, const PolygonOptions& options)
+    {
+        if (options.vertexDistribution == "small")
+        {
+            int count = options.minVertexes;
+            while (count < options.maxVertexes && random.chance(0.5))
+            {
+                ++count;
+            }
+            return count;
+        }
+        return static_cast< int >(random.range(options.minVertexes, options.maxVertexes));
+    }
+
+    inline Polygon randomPolygon(Random& random, const PolygonOptions& options)
+    {
+        Polygon polygon(randomVertexCount(random, options));
+        const int range = options.coordinateRange;
+        for (auto& point : polygon)
+        {
+            point.first = static_cast< int >(random.range(-range, range));
+            point.second = static_cast< int >(random.range(-range, range));
+        }
+        return polygon;
+    }
+
+    // Same shape moved, started from another vertex and possibly walked backwards.
+    inline Polygon congruentCopy(Random& random, const Polygon& polygon, int coordinateRange)
+    {
+        Polygon copy = polygon;
+        int dx = static_cast< int >(random.range(-coordinateRange, coordinateRange));
+        int dy = static_cast< int >(random.range(-coordinateRange, coordinateRange));
+        for (auto& point : copy)
+        {
+            point.first += dx;
+            point.second += dy;
+        }
+        std::rotate(copy.begin(), copy.begin() + random.range(0, copy.size() - 1), copy.end());
+        if (random.chance(0.5))
+        {
+            std::reverse(copy.begin(), copy.end());
+        }
+        return copy;
+    }
+
+    inline std::string invalidPolygonLine(Random& random, const PolygonOptions& options)
+    {
+        Polygon polygon = randomPolygon(random, options);
+        std::string line = formatPolygon(polygon);
+        switch (random.range(0, 3))
+        {
+        case 0:
+            return "2 (0;0) (1;1)";
+        case 1:
+            return std::to_string(polygon.size() + 1) + line.substr(line.find(' '));
+        case 2:
+            std::replace(line.begin(), line.end(), ';', ',');
+            return line;
+        default:
+            return "garbage " + line;
+        }
+    }
+
+    // Writes the polygon file and returns the valid polygons in file order.
+    inline std::vector< Polygon > writePolygons(std::ostream& out, Random& random,
+        const PolygonOptions& options)
+    {
+        std::vector< Polygon > polygons;
+        polygons.reserve(options.count);
+        while (polygons.size() < options.count)
+        {
+            if (random.chance(options.invalidRatio))
+            {
+                out << invalidPolygonLine(random, options) << '\n';
+                continue;
+            }
+            Polygon polygon;
+            if (!polygons.empty() && random.chance(options.duplicateRatio))
+            {
+                const Polygon& original = polygons[random.range(0, polygons.size() - 1)];
+                polygon = random.chance(0.5) ? original
+                    : congruentCopy(random, original, options.coordinateRange);
+            }
+            else
+            {
+                polygon = randomPolygon(random, options);
+            }
+            out << formatPolygon(polygon) << '\n';
+            polygons.push_back(std::move(polygon));
+        }
+        return polygons;
+    }
+
+    inline std::string randomPolygonArgument(Random& random, const std::vector< Polygon >& polygons,
+        const PolygonOptions& options)
+    {
+        if (!polygons.empty() && random.chance(0.5))
+        {
+            return formatPolygon(polygons[random.range(0, polygons.size() - 1)]);
+        }
+        return formatPolygon(randomPolygon(random, options));
+    }
+
+    inline std::string randomCommand(Random& random, const std::string& type,
+        const std::vector< Polygon >& polygons, const PolygonOptions& options)
+    {
+        const std::string vertexes = std::to_string(randomVertexCount(random, options));
+        if (type == "AREA")
+        {
+            const char* params[] = { "EVEN", "ODD", "MEAN" };
+            return "AREA " + (random.chance(0.25) ? vertexes : params[random.range(0, 2)]);
+        }
+        if (type == "COUNT")
+        {
+            const char* params[] = { "EVEN", "ODD" };
+            return "COUNT " + (random.chance(0.34) ? vertexes : params[random.range(0, 1)]);
+        }
+        if (type == "MAX" || type == "MIN")
+        {
+            return type + (random.chance(0.5) ? " AREA" : " VERTEXES");
+        }
+        if (type == "SAME" || type == "PERMS" || type == "ECHO" || type == "INFRAME")
+        {
+            return type + " " + randomPolygonArgument(random, polygons, options);
+        }
+        return type;
+    }
+
+    inline std::string invalidCommand(Random& random, const std::string& type)
+    {
+        switch (random.range(0, 2))
+        {
+        case 0:
+            return type + " BOGUS";
+        case 1:
+            return type + " 3 (0;0) (1;1)";
+        default:
+            return "NOSUCHCOMMAND";
+        }
+    }
+
+    // perType commands of every type, interleaved in a seeded order.
+    inline void writeCommands(std::ostream& out, Random& random, const CommandOptions& commands,
+        const std::vector< Polygon >& polygons, const PolygonOptions& options)
+    {
+        std::vector< std::string > lines;
+        for (const auto& type : commands.types)
+        {
+            for (std::size_t i = 0; i < commands.perType; ++i)
+            {
+                lines.push_back(random.chance(commands.invalidRatio) ? invalidCommand(random, type)
+                    : randomCommand(random, type, polygons, options));
+            }
+        }
+        for (std::size_t i = lines.size(); i > 1; --i)
+        {
+            std::swap(lines[i - 1], lines[random.range(0, i - 1)]);
+        }
+        for (const auto& line : lines)
+        {
+            out << line << '\n';
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef BENCH_PROCESS_H
+#define BENCH_PROCESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bench
+{
+    struct ProcessResult
+    {
+        int exitStatus = -1;
+        std::uint64_t wallNs = 0;
+        std::uint64_t maxRssKb = 0;
+    };
+
+    // Runs argv[0] with stdin, stdout and stderr redirected to the given files and
+    // reports its wall time and peak RSS. An empty path leaves the stream inherited.
+    inline ProcessResult runProcess(const std::vector< std::string >& argv,
+        const std::string& input, const std::string& output, const std::string& errors)
+    {
+        std::vector< char* > args;
+        for (const auto& arg : argv)
+        {
+            args.push_back(const_cast< char* >(arg.c_str()));
+        }
+        args.push_back(nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            throw std::runtime_error("fork failed");
+        }
+        if (pid == 0)
+        {
+            const std::string* paths[] = { &input, &output, &errors };
+            for (int fd = 0; fd < 3; ++fd)
+            {
+                if (paths[fd]->empty())
+                {
+                    continue;
+                }
+                int flags = fd == 0 ? O_RDONLY : O_WRONLY | O_CREAT | O_TRUNC;
+                int file = open(paths[fd]->c_str(), flags, 0644);
+                if (file < 0 || dup2(file, fd) < 0)
+                {
+                    _exit(127);
+                }
+                close(file);
+            }
+            execv(args[0], args.data());
+            _exit(127);
+        }
+
+        int status = 0;
+        rusage usage{};
+        if (wait4(pid, &status, 0, &usage) < 0)
+        {
+            throw std::runtime_error("wait4 failed");
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        ProcessResult result;
+        result.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+        result.wallNs = std::chrono::duration_cast< std::chrono::nanoseconds >(elapsed).count();
+        result.maxRssKb = usage.ru_maxrss;
+        return result;
+    }
+
+    inline void makeDirectory(const std::string& path)
+    {
+        std::string prefix;
+        for (std::size_t i = 0; i <= path.size(); ++i)
+        {
+            if (i == path.size() || path[i] == '/')
+            {
+                if (!prefix.empty())
+                {
+                    mkdir(prefix.c_str(), 0755);
+                }
+            }
+            if (i < path.size())
+            {
+                prefix += path[i];
+            }
+        }
+    }
+}
+
+#endif
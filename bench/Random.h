@@ -0,0 +1,47 @@
+#ifndef BENCH_RANDOM_H
+#define BENCH_RANDOM_H
+
+#include <cstdint>
+
+namespace bench
+{
+    // SplitMix64. Unlike the <random> distributions its output is fixed across standard
+    // libraries, so a seed names the same workload everywhere.
+    class Random
+    {
+    public:
+        explicit Random(std::uint64_t seed) :
+            state_(seed)
+        {}
+
+        std::uint64_t next()
+        {
+            std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        // Uniform in [low, high].
+        long long range(long long low, long long high)
+        {
+            std::uint64_t span = static_cast< std::uint64_t >(high - low) + 1;
+            return low + static_cast< long long >(span == 0 ? next() : next() % span);
+        }
+
+        double unit()
+        {
+            return (next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        bool chance(double probability)
+        {
+            return unit() < probability;
+        }
+
+    private:
+        std::uint64_t state_;
+    };
+}
+
+#endif
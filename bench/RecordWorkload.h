@@ -0,0 +1,205 @@
+#ifndef BENCH_RECORD_WORKLOAD_H
+#define BENCH_RECORD_WORKLOAD_H
+
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "Arguments.h"
+#include "Random.h"
+
+namespace bench
+{
+    struct RecordOptions
+    {
+        // Whose T2 grammar to write, the name of the student's directory.
+        std::string variant;
+        // Valid records; malformed lines come on top.
+        std::size_t count = 100000;
+        double garbageRatio = 0.05;
+        // Numbers are drawn from [-keyRange, keyRange], so a small range makes ties.
+        long long keyRange = 1000;
+        std::size_t maxText = 16;
+    };
+
+    inline RecordOptions recordOptionsFrom(const Arguments& args)
+    {
+        RecordOptions options;
+        options.variant = args.get("variant", options.variant);
+        options.count = args.getInt("records", options.count);
+        options.garbageRatio = args.getDouble("garbage-ratio", options.garbageRatio);
+        options.keyRange = args.getInt("key-range", options.keyRange);
+        options.maxText = args.getInt("max-text", options.maxText);
+        return options;
+    }
+
+    inline std::string formatNumber(const char* format, long long first, long long second = 0)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), format, first, second);
+        return buffer;
+    }
+
+    // Literals of the key types, with values in [-range, range] where signed.
+
+    inline std::string doubleLiteral(Random& random, long long range)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.1fd",
+            random.range(-range * 10, range * 10) / 10.0);
+        return buffer;
+    }
+
+    inline std::string complexLiteral(Random& random, long long range)
+    {
+        long long real = random.range(-range, range);
+        long long imag = random.range(-range, range);
+        return formatNumber("#c(%lld.0 %lld.0)", real, imag);
+    }
+
+    inline std::string rationalLiteral(Random& random, long long range)
+    {
+        long long numerator = random.range(-range, range);
+        long long denominator = random.range(1, range < 1 ? 1 : range);
+        return formatNumber("(:N %lld:D %lld:)", numerator, denominator);
+    }
+
+    inline std::string signedLiteral(Random& random, long long range)
+    {
+        return formatNumber("%lldll", random.range(-range, range));
+    }
+
+    inline std::string unsignedLiteral(Random& random, long long range)
+    {
+        return formatNumber("%lldull", random.range(0, range));
+    }
+
+    inline std::string octalLiteral(Random& random, long long range)
+    {
+        return formatNumber("0%llo", random.range(0, range));
+    }
+
+    inline std::string hexLiteral(Random& random, long long range)
+    {
+        return formatNumber("0x%llX", random.range(0, range));
+    }
+
+    // kovalchuk.egor reads its literals as whitespace-separated tokens.
+
+    inline std::string doubleToken(Random& random, long long range)
+    {
+        return doubleLiteral(random, range) + ' ';
+    }
+
+    inline std::string unsignedToken(Random& random, long long range)
+    {
+        return unsignedLiteral(random, range) + ' ';
+    }
+
+    // The literals of key1 and key2 of a variant; key3 is always a string.
+    struct RecordGrammar
+    {
+        const char* variant;
+        std::string (*key1)(Random&, long long);
+        std::string (*key2)(Random&, long long);
+        // The lab stops reading at the first malformed line instead of skipping it,
+        // so its workloads have none.
+        bool stopsAtMalformed;
+    };
+
+    const RecordGrammar RECORD_GRAMMARS[] = {
+        { "barkanov.nikita", octalLiteral, complexLiteral, false },
+        { "ivashin.dannil", unsignedLiteral, hexLiteral, false },
+        { "kalashyan.arthur", complexLiteral, rationalLiteral, false },
+        { "karmanova.alyona", unsignedLiteral, complexLiteral, false },
+        { "karyakin.platon", signedLiteral, rationalLiteral, false },
+        { "kolosov.ivan", doubleLiteral, rationalLiteral, false },
+        { "kovalchuk.egor", doubleToken, unsignedToken, true }
+    };
+
+    inline const RecordGrammar& recordGrammar(const std::string& variant)
+    {
+        std::string known;
+        for (const auto& grammar : RECORD_GRAMMARS)
+        {
+            if (variant == grammar.variant)
+            {
+                return grammar;
+            }
+            known += known.empty() ? "" : ", ";
+            known += grammar.variant;
+        }
+        throw std::invalid_argument("unknown T2 variant '" + variant + "', expected one of "
+            + known);
+    }
+
+    inline std::string randomText(Random& random, std::size_t maxText)
+    {
+        std::string text(random.range(0, maxText), ' ');
+        for (auto& c : text)
+        {
+            c = static_cast< char >('a' + random.range(0, 25));
+        }
+        return text;
+    }
+
+    // The fields in a random order, one record per line.
+    inline std::string recordLine(Random& random, const RecordGrammar& grammar,
+        const RecordOptions& options)
+    {
+        std::string fields[] = {
+            ":key1 " + grammar.key1(random, options.keyRange),
+            ":key2 " + grammar.key2(random, options.keyRange),
+            ":key3 \"" + randomText(random, options.maxText) + '"'
+        };
+        for (std::size_t i = 2; i > 0; --i)
+        {
+            std::swap(fields[i], fields[random.range(0, i)]);
+        }
+        return '(' + fields[0] + fields[1] + fields[2] + ":)";
+    }
+
+    // A line that fails in every variant before its end, without a '(' that
+    // a reader skipping to the next record could start over at.
+    inline std::string malformedLine(Random& random, const RecordGrammar& grammar,
+        const RecordOptions& options)
+    {
+        std::string line = recordLine(random, grammar, options);
+        switch (random.range(0, 2))
+        {
+        case 0:
+            // Unknown label.
+            line.replace(line.find(":key") + 4, 1, "4");
+            return line;
+        case 1:
+            // Bad literal.
+            line.insert(line.find(random.chance(0.5) ? ":key1 " : ":key2 ") + 6, "x");
+            return line;
+        default:
+            return "garbage " + randomText(random, options.maxText) + " :key1 :)";
+        }
+    }
+
+    // Writes options.count valid records with malformed lines in between, unless
+    // the variant stops at the first of them.
+    inline void writeRecords(std::ostream& out, Random& random, const RecordOptions& options)
+    {
+        const RecordGrammar& grammar = recordGrammar(options.variant);
+        const double garbageRatio = grammar.stopsAtMalformed ? 0.0 : options.garbageRatio;
+        std::size_t written = 0;
+        while (written < options.count)
+        {
+            if (random.chance(garbageRatio))
+            {
+                out << malformedLine(random, grammar, options) << '\n';
+                continue;
+            }
+            out << recordLine(random, grammar, options) << '\n';
+            ++written;
+        }
+    }
+}
+
+#endif
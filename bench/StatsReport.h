@@ -0,0 +1,80 @@
+#ifndef BENCH_STATS_REPORT_H
+#define BENCH_STATS_REPORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    // Parsed "stats ..." lines written by an engine run with --stats. Phases and commands
+    // map their fields (ns, count, p50_ns, ...) to values.
+    struct StatsRun
+    {
+        std::map< std::string, std::uint64_t > phases;
+        std::map< std::string, std::map< std::string, std::uint64_t > > commands;
+        std::uint64_t maxRssKb = 0;
+    };
+
+    inline StatsRun parseStats(std::istream& in)
+    {
+        StatsRun run;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::istringstream fields(line);
+            std::string tag;
+            if (!(fields >> tag) || tag != "stats")
+            {
+                continue;
+            }
+            std::map< std::string, std::string > values;
+            std::string field;
+            while (fields >> field)
+            {
+                std::string::size_type eq = field.find('=');
+                if (eq != std::string::npos)
+                {
+                    values[field.substr(0, eq)] = field.substr(eq + 1);
+                }
+            }
+            if (values.count("phase") && values.count("ns"))
+            {
+                run.phases[values["phase"]] = std::stoull(values["ns"]);
+            }
+            else if (values.count("command"))
+            {
+                auto& command = run.commands[values["command"]];
+                for (const auto& value : values)
+                {
+                    if (value.first != "command")
+                    {
+                        command[value.first] = std::stoull(value.second);
+                    }
+                }
+            }
+            else if (values.count("max_rss_kb"))
+            {
+                run.maxRssKb = std::stoull(values["max_rss_kb"]);
+            }
+        }
+        return run;
+    }
+
+    inline double median(std::vector< double > values)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        std::size_t middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+}
+
+#endif
@@ -0,0 +1,176 @@
+// Times the T2 labs phase by phase, each on a workload in its own grammar, and prints one
+// row per lab.
+//
+//   bench-t2 --lab VARIANT=PATH [--lab VARIANT=PATH ...] [--reps N] [--workdir DIR]
+//       [--seed N] [gen-t2 workload options]
+//
+// VARIANT names the grammar, as in gen-t2 --variant. Every workload has the same number of
+// valid records and the same garbage ratio, except for variants that stop at the first
+// malformed line, which get none. Each lab is run --reps times with --stats and
+// reports its parse, sort and print phases; the report shows medians over the repetitions:
+// parse MB/s of input, sorted records/s, print MB/s of output, total wall time and peak RSS.
+// A lab whose output does not have one record line, starting with '(', per valid record is
+// an error; other lines, like a trailing stream status, are not counted.
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "Process.h"
+#include "RecordWorkload.h"
+#include "StatsReport.h"
+
+namespace
+{
+    struct Lab
+    {
+        std::string variant;
+        std::string path;
+    };
+
+    // metric name -> one value per repetition
+    using Samples = std::map< std::string, std::vector< double > >;
+
+    const char* const METRICS[] = { "input_mb", "parse_mb_s", "sort_rec_s", "print_mb_s",
+        "total_ms", "max_rss_kb" };
+
+    std::vector< Lab > parseLabs(const bench::Arguments& args)
+    {
+        std::vector< Lab > labs;
+        for (const auto& spec : args.getAll("lab"))
+        {
+            std::string::size_type eq = spec.find('=');
+            if (eq == std::string::npos)
+            {
+                throw std::invalid_argument("--lab expects VARIANT=PATH, got " + spec);
+            }
+            labs.push_back(Lab{ spec.substr(0, eq), spec.substr(eq + 1) });
+            bench::recordGrammar(labs.back().variant);
+        }
+        if (labs.empty())
+        {
+            throw std::invalid_argument("at least one --lab is required");
+        }
+        return labs;
+    }
+
+    // Size in bytes and number of lines starting with '('.
+    std::pair< std::uint64_t, std::uint64_t > measureFile(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::uint64_t bytes = 0;
+        std::uint64_t records = 0;
+        char previous = '\n';
+        char buffer[1 << 16];
+        while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+        {
+            bytes += in.gcount();
+            for (std::streamsize i = 0; i < in.gcount(); ++i)
+            {
+                records += previous == '\n' && buffer[i] == '(';
+                previous = buffer[i];
+            }
+        }
+        return { bytes, records };
+    }
+
+    double perSecond(double amount, std::uint64_t ns)
+    {
+        return ns > 0 ? amount / (ns / 1e9) : 0;
+    }
+
+    Samples measure(const Lab& lab, const std::string& input, std::size_t records,
+        const std::string& workdir, int reps)
+    {
+        const std::string output = workdir + "/" + lab.variant + ".out";
+        const std::string statsFile = workdir + "/" + lab.variant + ".stats";
+        const double inputBytes = measureFile(input).first;
+        Samples samples;
+        for (int rep = 0; rep < reps; ++rep)
+        {
+            bench::ProcessResult run = bench::runProcess({ lab.path, "--stats" }, input, output,
+                statsFile);
+            if (run.exitStatus != 0)
+            {
+                throw std::runtime_error(lab.variant + " exited with status "
+                    + std::to_string(run.exitStatus));
+            }
+            const auto written = measureFile(output);
+            if (written.second != records)
+            {
+                throw std::runtime_error(lab.variant + " printed " + std::to_string(written.second)
+                    + " records of " + std::to_string(records));
+            }
+            std::ifstream in(statsFile);
+            bench::StatsRun stats = bench::parseStats(in);
+            samples["input_mb"].push_back(inputBytes / 1e6);
+            samples["parse_mb_s"].push_back(perSecond(inputBytes / 1e6, stats.phases["parse"]));
+            samples["sort_rec_s"].push_back(perSecond(records, stats.phases["sort"]));
+            samples["print_mb_s"].push_back(perSecond(written.first / 1e6,
+                stats.phases["print"]));
+            samples["total_ms"].push_back(run.wallNs / 1e6);
+            samples["max_rss_kb"].push_back(run.maxRssKb);
+        }
+        return samples;
+    }
+
+    void printReport(const std::vector< Lab >& labs, const std::vector< Samples >& results)
+    {
+        std::cout << std::left << std::setw(20) << "lab" << std::right;
+        for (const char* metric : METRICS)
+        {
+            std::cout << std::setw(14) << metric;
+        }
+        std::cout << '\n' << std::fixed << std::setprecision(1);
+        for (std::size_t i = 0; i < labs.size(); ++i)
+        {
+            std::cout << std::left << std::setw(20) << labs[i].variant << std::right;
+            for (const char* metric : METRICS)
+            {
+                auto it = results[i].find(metric);
+                double value = it == results[i].end() ? 0.0 : bench::median(it->second);
+                std::cout << std::setw(14) << value;
+            }
+            std::cout << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        bench::Arguments args(argc, argv);
+        std::vector< Lab > labs = parseLabs(args);
+        const int reps = static_cast< int >(args.getInt("reps", 5));
+        const std::string workdir = args.get("workdir", "out/bench/t2");
+        bench::makeDirectory(workdir);
+
+        bench::RecordOptions options = bench::recordOptionsFrom(args);
+        std::vector< Samples > results;
+        for (const auto& lab : labs)
+        {
+            options.variant = lab.variant;
+            const std::string input = workdir + "/" + lab.variant + ".txt";
+            bench::Random random(args.getInt("seed", 1));
+            std::ofstream inputFile(input);
+            bench::writeRecords(inputFile, random, options);
+            if (!inputFile.flush())
+            {
+                throw std::runtime_error("could not write the workload to " + workdir);
+            }
+            results.push_back(measure(lab, input, options.count, workdir, reps));
+        }
+
+        std::cout << "# records=" << options.count << " garbage_ratio=" << options.garbageRatio
+            << " key_range=" << options.keyRange << " reps=" << reps << " seed="
+            << args.getInt("seed", 1) << '\n';
+        printReport(labs, results);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+// Times the T3 polygon engines on one generated workload and prints them side by side.
+//
+//   bench-t3 --engine NAME=PATH [--engine NAME=PATH ...] [--reps N] [--workdir DIR]
+//       [gen-polygons workload options]
+//
+// Every engine is run --reps times without commands (load only) and --reps times on the
+// command script with --stats; the report shows medians over the repetitions. Ratios in
+// parentheses compare an engine against the first one.
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "PolygonWorkload.h"
+#include "Process.h"
+#include "StatsReport.h"
+
+namespace
+{
+    struct Engine
+    {
+        std::string name;
+        std::string path;
+    };
+
+    // metric name -> one value per repetition
+    using Samples = std::map< std::string, std::vector< double > >;
+
+    const char* const ALL_COMMANDS = "AREA,COUNT,MAX,MIN,RECTS,SAME,PERMS,ECHO,INFRAME,RIGHTSHAPES";
+
+    std::vector< Engine > parseEngines(const bench::Arguments& args)
+    {
+        std::vector< Engine > engines;
+        for (const auto& spec : args.getAll("engine"))
+        {
+            std::string::size_type eq = spec.find('=');
+            if (eq == std::string::npos)
+            {
+                throw std::invalid_argument("--engine expects NAME=PATH, got " + spec);
+            }
+            engines.push_back(Engine{ spec.substr(0, eq), spec.substr(eq + 1) });
+        }
+        if (engines.empty())
+        {
+            throw std::invalid_argument("at least one --engine is required");
+        }
+        return engines;
+    }
+
+    void checkRun(const Engine& engine, const bench::ProcessResult& result)
+    {
+        if (result.exitStatus != 0)
+        {
+            throw std::runtime_error(engine.name + " exited with status "
+                + std::to_string(result.exitStatus));
+        }
+    }
+
+    Samples measure(const Engine& engine, const std::string& workdir, int reps)
+    {
+        const std::string polygons = workdir + "/polygons.txt";
+        const std::string statsFile = workdir + "/stats.txt";
+        Samples samples;
+        for (int rep = 0; rep < reps; ++rep)
+        {
+            bench::ProcessResult load = bench::runProcess({ engine.path, polygons },
+                workdir + "/empty.txt", "/dev/null", "/dev/null");
+            checkRun(engine, load);
+            samples["wall.load_ms"].push_back(load.wallNs / 1e6);
+
+            bench::ProcessResult run = bench::runProcess({ engine.path, polygons, "--stats" },
+                workdir + "/commands.txt", "/dev/null", statsFile);
+            checkRun(engine, run);
+            samples["wall.total_ms"].push_back(run.wallNs / 1e6);
+            samples["max_rss_kb"].push_back(run.maxRssKb);
+
+            std::ifstream in(statsFile);
+            bench::StatsRun stats = bench::parseStats(in);
+            for (const auto& phase : stats.phases)
+            {
+                samples["phase." + phase.first + "_ms"].push_back(phase.second / 1e6);
+            }
+            for (const auto& command : stats.commands)
+            {
+                auto fields = command.second;
+                const std::string prefix = command.first + ".";
+                double seconds = fields["total_ns"] / 1e9;
+                samples[prefix + "count"].push_back(fields["count"]);
+                samples[prefix + "errors"].push_back(fields["errors"]);
+                samples[prefix + "per_s"].push_back(seconds > 0 ? fields["count"] / seconds : 0);
+                samples[prefix + "p50_us"].push_back(fields["p50_ns"] / 1e3);
+                samples[prefix + "p99_us"].push_back(fields["p99_ns"] / 1e3);
+                samples[prefix + "max_us"].push_back(fields["max_ns"] / 1e3);
+            }
+        }
+        return samples;
+    }
+
+    void printReport(const std::vector< Engine >& engines, const std::vector< Samples >& results)
+    {
+        std::map< std::string, bool > metrics;
+        for (const auto& samples : results)
+        {
+            for (const auto& metric : samples)
+            {
+                metrics[metric.first] = true;
+            }
+        }
+        std::cout << std::left << std::setw(24) << "metric";
+        for (const auto& engine : engines)
+        {
+            std::cout << std::setw(26) << engine.name;
+        }
+        std::cout << '\n' << std::fixed << std::setprecision(3);
+        for (const auto& metric : metrics)
+        {
+            std::cout << std::setw(24) << metric.first;
+            double base = 0.0;
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                auto it = results[i].find(metric.first);
+                if (it == results[i].end())
+                {
+                    std::cout << std::setw(26) << "-";
+                    continue;
+                }
+                double value = bench::median(it->second);
+                std::ostringstream cell;
+                cell << std::fixed << std::setprecision(3) << value;
+                if (i == 0)
+                {
+                    base = value;
+                }
+                else if (base != 0.0)
+                {
+                    cell << " (x" << std::setprecision(2) << value / base << ')';
+                }
+                std::cout << std::setw(26) << cell.str();
+            }
+            std::cout << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        bench::Arguments args(argc, argv);
+        std::vector< Engine > engines = parseEngines(args);
+        const int reps = static_cast< int >(args.getInt("reps", 5));
+        const std::string workdir = args.get("workdir", "out/bench/t3");
+        bench::makeDirectory(workdir);
+
+        bench::Random random(args.getInt("seed", 1));
+        bench::PolygonOptions options = bench::polygonOptionsFrom(args);
+        bench::CommandOptions commands = bench::commandOptionsFrom(args);
+        if (args.get("command-types", "").empty())
+        {
+            commands.types = bench::splitList(ALL_COMMANDS);
+        }
+        std::ofstream polygonFile(workdir + "/polygons.txt");
+        std::vector< bench::Polygon > valid = bench::writePolygons(polygonFile, random, options);
+        std::ofstream commandFile(workdir + "/commands.txt");
+        bench::writeCommands(commandFile, random, commands, valid, options);
+        std::ofstream emptyFile(workdir + "/empty.txt");
+        if (!polygonFile.flush() || !commandFile.flush() || !emptyFile.flush())
+        {
+            throw std::runtime_error("could not write the workload to " + workdir);
+        }
+
+        std::cout << "# polygons=" << options.count << " commands_per_type=" << commands.perType
+            << " reps=" << reps << " seed=" << args.getInt("seed", 1) << '\n';
+        std::vector< Samples > results;
+        for (const auto& engine : engines)
+        {
+            results.push_back(measure(engine, workdir, reps));
+        }
+        printReport(engines, results);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,279 @@
+// Feeds the same randomized polygon files and command scripts to several T3 engines and
+// compares their output with the first engine's.
+//
+//   diff-t3 --engine NAME=PATH --engine NAME=PATH [...] [--cases N] [--seed N]
+//       [--max-polygons N] [--max-commands N] [--max-failures N] [--workdir DIR]
+//       [--command-types AREA,COUNT,...] [gen-polygons workload options]
+//
+// A case fails when an engine's stdout or exit status differs from the reference. Each
+// failure is shrunk by dropping polygon and command lines while it still fails, and the
+// minimal reproducer is left in DIR/failure-N with every engine's output. Per-engine timings
+// over the generated cases are reported at the end.
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "PolygonWorkload.h"
+#include "Process.h"
+
+namespace
+{
+    struct Engine
+    {
+        std::string name;
+        std::string path;
+        std::uint64_t wallNs = 0;
+        std::uint64_t runs = 0;
+    };
+
+    struct Case
+    {
+        std::vector< std::string > polygons;
+        std::vector< std::string > commands;
+    };
+
+    struct Outcome
+    {
+        int exitStatus;
+        std::string output;
+    };
+
+    // Common to both engines; the others answer <INVALID COMMAND> in one of them.
+    const char* const SHARED_COMMANDS = "AREA,COUNT,MAX,MIN";
+
+    std::vector< Engine > parseEngines(const bench::Arguments& args)
+    {
+        std::vector< Engine > engines;
+        for (const auto& spec : args.getAll("engine"))
+        {
+            std::string::size_type eq = spec.find('=');
+            if (eq == std::string::npos)
+            {
+                throw std::invalid_argument("--engine expects NAME=PATH, got " + spec);
+            }
+            Engine engine;
+            engine.name = spec.substr(0, eq);
+            engine.path = spec.substr(eq + 1);
+            engines.push_back(engine);
+        }
+        if (engines.size() < 2)
+        {
+            throw std::invalid_argument("at least two --engine options are required");
+        }
+        return engines;
+    }
+
+    std::vector< std::string > splitLines(const std::string& text)
+    {
+        std::vector< std::string > lines;
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream content;
+        content << in.rdbuf();
+        return content.str();
+    }
+
+    void writeLines(const std::string& path, const std::vector< std::string >& lines)
+    {
+        std::ofstream out(path);
+        for (const auto& line : lines)
+        {
+            out << line << '\n';
+        }
+    }
+
+    Case randomCase(bench::Random& random, const bench::Arguments& args)
+    {
+        bench::PolygonOptions options = bench::polygonOptionsFrom(args);
+        bench::CommandOptions commands = bench::commandOptionsFrom(args);
+        if (args.get("command-types", "").empty())
+        {
+            commands.types = bench::splitList(SHARED_COMMANDS);
+        }
+        // Every tenth case has no polygons at all, to cover the empty-dataset answers.
+        options.count = random.chance(0.1) ? 0 : random.range(1, args.getInt("max-polygons", 20));
+        const std::size_t totalCommands = random.range(1, args.getInt("max-commands", 20));
+        commands.perType = (totalCommands + commands.types.size() - 1) / commands.types.size();
+        commands.invalidRatio = args.getDouble("invalid-command-ratio", 0.2);
+
+        std::ostringstream polygonText;
+        std::vector< bench::Polygon > valid = bench::writePolygons(polygonText, random, options);
+        std::ostringstream commandText;
+        bench::writeCommands(commandText, random, commands, valid, options);
+        return Case{ splitLines(polygonText.str()), splitLines(commandText.str()) };
+    }
+
+    // Engine names are usually lab ids, which contain '/'.
+    std::string outputPath(const std::string& dir, const Engine& engine)
+    {
+        std::string name = engine.name;
+        std::replace(name.begin(), name.end(), '/', '_');
+        return dir + "/out-" + name + ".txt";
+    }
+
+    Outcome run(Engine& engine, const std::string& dir)
+    {
+        const std::string output = outputPath(dir, engine);
+        bench::ProcessResult result = bench::runProcess({ engine.path, dir + "/polygons.txt" },
+            dir + "/commands.txt", output, "/dev/null");
+        engine.wallNs += result.wallNs;
+        ++engine.runs;
+        return Outcome{ result.exitStatus, readFile(output) };
+    }
+
+    // Index of the first engine that disagrees with engines[0], or 0 when all agree.
+    std::size_t findMismatch(std::vector< Engine >& engines, const Case& testCase,
+        const std::string& dir, std::vector< Outcome >& outcomes)
+    {
+        writeLines(dir + "/polygons.txt", testCase.polygons);
+        writeLines(dir + "/commands.txt", testCase.commands);
+        outcomes.clear();
+        for (auto& engine : engines)
+        {
+            outcomes.push_back(run(engine, dir));
+        }
+        for (std::size_t i = 1; i < outcomes.size(); ++i)
+        {
+            if (outcomes[i].exitStatus != outcomes[0].exitStatus
+                || outcomes[i].output != outcomes[0].output)
+            {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    // Drops chunks of lines, halving the chunk size, for as long as the case still fails.
+    bool shrinkLines(std::vector< std::string > Case::* lines, Case& testCase,
+        std::vector< Engine >& engines, const std::string& dir)
+    {
+        bool shrunk = false;
+        std::vector< Outcome > outcomes;
+        for (std::size_t chunk = ((testCase.*lines).size() + 1) / 2; chunk > 0; chunk /= 2)
+        {
+            for (std::size_t start = 0; start < (testCase.*lines).size();)
+            {
+                Case candidate = testCase;
+                auto& candidateLines = candidate.*lines;
+                std::size_t end = std::min(start + chunk, candidateLines.size());
+                candidateLines.erase(candidateLines.begin() + start, candidateLines.begin() + end);
+                if (findMismatch(engines, candidate, dir, outcomes) != 0)
+                {
+                    testCase = candidate;
+                    shrunk = true;
+                }
+                else
+                {
+                    start += chunk;
+                }
+            }
+        }
+        return shrunk;
+    }
+
+    void shrink(Case& testCase, std::vector< Engine >& engines, const std::string& dir)
+    {
+        bool shrunk = true;
+        while (shrunk)
+        {
+            shrunk = shrinkLines(&Case::commands, testCase, engines, dir);
+            shrunk = shrinkLines(&Case::polygons, testCase, engines, dir) || shrunk;
+        }
+    }
+
+    // Expects the last run of the engines to have been on testCase, so that the reproducer
+    // files and per-engine outputs in dir are the ones of the minimal case.
+    void reportFailure(const std::vector< Engine >& engines, const Case& testCase,
+        const std::vector< Outcome >& outcomes, std::size_t other, const std::string& dir)
+    {
+        std::cout << "FAIL " << engines[0].name << " vs " << engines[other].name
+            << " (" << testCase.polygons.size() << " polygon lines, "
+            << testCase.commands.size() << " commands), reproducer in " << dir << '\n';
+        std::vector< std::string > expected = splitLines(outcomes[0].output);
+        std::vector< std::string > actual = splitLines(outcomes[other].output);
+        for (std::size_t i = 0; i < std::max(expected.size(), actual.size()); ++i)
+        {
+            std::string left = i < expected.size() ? expected[i] : "<none>";
+            std::string right = i < actual.size() ? actual[i] : "<none>";
+            if (left != right)
+            {
+                std::string command = i < testCase.commands.size() ? testCase.commands[i] : "?";
+                std::cout << "  output line " << i + 1 << " (after '" << command << "'): "
+                    << engines[0].name << " '" << left << "', "
+                    << engines[other].name << " '" << right << "'\n";
+                break;
+            }
+        }
+        if (outcomes[0].exitStatus != outcomes[other].exitStatus)
+        {
+            std::cout << "  exit status " << outcomes[0].exitStatus << " vs "
+                << outcomes[other].exitStatus << '\n';
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        bench::Arguments args(argc, argv);
+        std::vector< Engine > engines = parseEngines(args);
+        const std::string workdir = args.get("workdir", "out/bench/diff-t3");
+        const long long cases = args.getInt("cases", 200);
+        const long long maxFailures = args.getInt("max-failures", 1);
+        bench::makeDirectory(workdir);
+
+        bench::Random random(args.getInt("seed", 1));
+        long long failures = 0;
+        long long done = 0;
+        std::vector< Outcome > outcomes;
+        for (; done < cases && failures < maxFailures; ++done)
+        {
+            Case testCase = randomCase(random, args);
+            std::size_t other = findMismatch(engines, testCase, workdir, outcomes);
+            if (other == 0)
+            {
+                continue;
+            }
+            ++failures;
+            const std::string dir = workdir + "/failure-" + std::to_string(failures);
+            bench::makeDirectory(dir);
+            // Shrinking reruns are not part of the timings.
+            const std::vector< Engine > timings = engines;
+            shrink(testCase, engines, dir);
+            other = findMismatch(engines, testCase, dir, outcomes);
+            engines = timings;
+            reportFailure(engines, testCase, outcomes, other, dir);
+        }
+
+        std::cout << "# cases=" << done << " failures=" << failures
+            << " seed=" << args.getInt("seed", 1) << '\n';
+        std::cout << std::left << std::setw(24) << "engine" << std::setw(10) << "runs"
+            << std::setw(14) << "total_ms" << "mean_ms" << '\n';
+        std::cout << std::fixed << std::setprecision(3);
+        for (const auto& engine : engines)
+        {
+            std::cout << std::setw(24) << engine.name << std::setw(10) << engine.runs
+                << std::setw(14) << engine.wallNs / 1e6
+                << (engine.runs ? engine.wallNs / 1e6 / engine.runs : 0.0) << '\n';
+        }
+        return failures == 0 ? 0 : 2;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,44 @@
+// Writes a deterministic polygon file and a matching command script for the T3 engines.
+//
+//   gen-polygons --polygon-file FILE --command-file FILE [--seed N] [--polygons N]
+//       [--min-vertexes N] [--max-vertexes N] [--vertex-distribution uniform|small]
+//       [--coordinate-range N] [--invalid-ratio R] [--duplicate-ratio R]
+//       [--command-types AREA,COUNT,...] [--commands-per-type N] [--invalid-command-ratio R]
+
+#include <fstream>
+#include <iostream>
+
+#include "PolygonWorkload.h"
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        bench::Arguments args(argc, argv);
+        std::string polygonFile = args.get("polygon-file", "");
+        std::string commandFile = args.get("command-file", "");
+        if (polygonFile.empty() || commandFile.empty())
+        {
+            std::cerr << "ERROR: --polygon-file and --command-file are required\n";
+            return 1;
+        }
+        bench::Random random(args.getInt("seed", 1));
+        bench::PolygonOptions options = bench::polygonOptionsFrom(args);
+
+        std::ofstream polygons(polygonFile);
+        std::vector< bench::Polygon > valid = bench::writePolygons(polygons, random, options);
+        std::ofstream commands(commandFile);
+        bench::writeCommands(commands, random, bench::commandOptionsFrom(args), valid, options);
+        if (!polygons || !commands)
+        {
+            std::cerr << "ERROR: could not write the workload\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
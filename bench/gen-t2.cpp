@@ -0,0 +1,42 @@
+// Writes a deterministic T2 record file in the grammar of one student's variant.
+//
+//   gen-t2 --variant NAME --output FILE [--seed N] [--records N] [--garbage-ratio R]
+//       [--key-range N] [--max-text N]
+//
+// --records valid records are written one per line; each line is a malformed one instead
+// with probability --garbage-ratio, unless the variant stops reading at the first malformed
+// line.
+
+#include <fstream>
+#include <iostream>
+
+#include "RecordWorkload.h"
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        bench::Arguments args(argc, argv);
+        std::string outputFile = args.get("output", "");
+        bench::RecordOptions options = bench::recordOptionsFrom(args);
+        if (outputFile.empty() || options.variant.empty())
+        {
+            std::cerr << "ERROR: --variant and --output are required\n";
+            return 1;
+        }
+        bench::Random random(args.getInt("seed", 1));
+        std::ofstream output(outputFile);
+        bench::writeRecords(output, random, options);
+        if (!output.flush())
+        {
+            std::cerr << "ERROR: could not write the workload\n";
+            return 1;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
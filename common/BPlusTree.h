@@ -0,0 +1,181 @@
+#ifndef COMMON_B_PLUS_TREE_H
+#define COMMON_B_PLUS_TREE_H
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace common
+{
+    // Sorted multiset for values that arrive one at a time. Values sit in
+    // leaves of up to NODE_CAPACITY in a contiguous array, linked in order;
+    // inner nodes route by the first value of each child and know how many
+    // values each subtree has, so both insertion and rank are O(log n).
+    // A value is inserted after every value comp leaves it equivalent to.
+    // T has to be default-constructible.
+    template < typename T, typename Compare >
+    class BPlusTree
+    {
+    public:
+        static const std::size_t NODE_CAPACITY = 64;
+
+        explicit BPlusTree(Compare comp = Compare()) :
+            comp_(comp),
+            root_(new Node(true))
+        {
+        }
+
+        BPlusTree(const BPlusTree&) = delete;
+        BPlusTree& operator=(const BPlusTree&) = delete;
+
+        std::size_t size() const
+        {
+            return root_->size;
+        }
+
+        void insert(const T& value)
+        {
+            T separator{};
+            std::unique_ptr< Node > sibling = insert(*root_, value, separator);
+            if (sibling)
+            {
+                std::unique_ptr< Node > root(new Node(false));
+                root->size = root_->size + sibling->size;
+                root->values.push_back(std::move(separator));
+                root->children.push_back(std::move(root_));
+                root->children.push_back(std::move(sibling));
+                root_ = std::move(root);
+            }
+        }
+
+        // Number of values before value: those less than it.
+        std::size_t rank(const T& value) const
+        {
+            std::size_t before = 0;
+            const Node* node = root_.get();
+            while (!node->leaf)
+            {
+                // Every value of the children left of the first separator not
+                // less than value is less than value.
+                std::size_t child = std::lower_bound(node->values.begin(), node->values.end(),
+                    value, comp_) - node->values.begin();
+                for (std::size_t i = 0; i < child; ++i)
+                {
+                    before += node->children[i]->size;
+                }
+                node = node->children[child].get();
+            }
+            auto found = std::lower_bound(node->values.begin(), node->values.end(), value, comp_);
+            return before + (found - node->values.begin());
+        }
+
+        // Calls f with every value in order.
+        template < typename F >
+        void forEach(F f) const
+        {
+            const Node* node = root_.get();
+            while (!node->leaf)
+            {
+                node = node->children.front().get();
+            }
+            for (; node; node = node->next)
+            {
+                for (const T& value : node->values)
+                {
+                    f(value);
+                }
+            }
+        }
+
+    private:
+        struct Node
+        {
+            explicit Node(bool isLeaf) :
+                leaf(isLeaf),
+                size(0),
+                next(nullptr)
+            {
+                values.reserve(NODE_CAPACITY + 1);
+            }
+
+            bool leaf;
+            // Values in the subtree.
+            std::size_t size;
+            // A leaf's values; in an inner node, values[i] is the first value
+            // of children[i + 1].
+            std::vector< T > values;
+            std::vector< std::unique_ptr< Node > > children;
+            // The next leaf.
+            Node* next;
+        };
+
+        Compare comp_;
+        std::unique_ptr< Node > root_;
+
+        std::size_t upperBound(const std::vector< T >& values, const T& value) const
+        {
+            return std::upper_bound(values.begin(), values.end(), value, comp_) - values.begin();
+        }
+
+        // Inserts into the subtree of node. If node had to be split, returns
+        // the new right half and stores the first value of it in separator.
+        std::unique_ptr< Node > insert(Node& node, const T& value, T& separator)
+        {
+            ++node.size;
+            if (node.leaf)
+            {
+                node.values.insert(node.values.begin() + upperBound(node.values, value), value);
+                if (node.values.size() <= NODE_CAPACITY)
+                {
+                    return nullptr;
+                }
+                std::unique_ptr< Node > sibling(new Node(true));
+                moveTail(node.values, sibling->values, node.values.size() / 2);
+                sibling->size = sibling->values.size();
+                node.size = node.values.size();
+                sibling->next = node.next;
+                node.next = sibling.get();
+                separator = sibling->values.front();
+                return sibling;
+            }
+
+            std::size_t child = upperBound(node.values, value);
+            std::unique_ptr< Node > split = insert(*node.children[child], value, separator);
+            if (!split)
+            {
+                return nullptr;
+            }
+            node.values.insert(node.values.begin() + child, std::move(separator));
+            node.children.insert(node.children.begin() + child + 1, std::move(split));
+            if (node.children.size() <= NODE_CAPACITY)
+            {
+                return nullptr;
+            }
+            // The middle separator moves up instead of into either half.
+            std::unique_ptr< Node > sibling(new Node(false));
+            const std::size_t keep = node.children.size() - node.children.size() / 2;
+            moveTail(node.children, sibling->children, keep);
+            moveTail(node.values, sibling->values, keep);
+            separator = std::move(node.values.back());
+            node.values.pop_back();
+            for (const auto& moved : sibling->children)
+            {
+                sibling->size += moved->size;
+            }
+            node.size -= sibling->size;
+            return sibling;
+        }
+
+        // Moves from[first] and everything after it to the end of to.
+        template < typename U >
+        static void moveTail(std::vector< U >& from, std::vector< U >& to, std::size_t first)
+        {
+            to.insert(to.end(), std::make_move_iterator(from.begin() + first),
+                std::make_move_iterator(from.end()));
+            from.erase(from.begin() + first, from.end());
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef COMMON_COMMAND_STATS_H
+#define COMMON_COMMAND_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace common
+{
+    // Log-linear latency histogram in the spirit of HdrHistogram: 16 sub-buckets
+    // per power of two, so every reported value is within 6.25% of the real one.
+    class LatencyHistogram
+    {
+    public:
+        LatencyHistogram() :
+            buckets_(BUCKETS, 0),
+            count_(0),
+            total_(0),
+            max_(0)
+        {
+        }
+
+        void record(std::uint64_t value)
+        {
+            ++buckets_[bucketOf(value)];
+            ++count_;
+            total_ += value;
+            if (value > max_)
+            {
+                max_ = value;
+            }
+        }
+
+        std::uint64_t count() const
+        {
+            return count_;
+        }
+
+        std::uint64_t total() const
+        {
+            return total_;
+        }
+
+        std::uint64_t max() const
+        {
+            return max_;
+        }
+
+        std::uint64_t percentile(double p) const
+        {
+            if (count_ == 0)
+            {
+                return 0;
+            }
+            std::uint64_t rank = static_cast< std::uint64_t >(p / 100.0 * count_ + 0.5);
+            rank = rank == 0 ? 1 : rank;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < buckets_.size(); ++i)
+            {
+                seen += buckets_[i];
+                if (seen >= rank)
+                {
+                    const std::uint64_t value = highestValueOf(i);
+                    return value < max_ ? value : max_;
+                }
+            }
+            return max_;
+        }
+
+    private:
+        static const unsigned SUB_BUCKET_BITS = 4;
+        static const std::uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+        static const std::size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        std::vector< std::uint64_t > buckets_;
+        std::uint64_t count_;
+        std::uint64_t total_;
+        std::uint64_t max_;
+
+        static unsigned highestBit(std::uint64_t value)
+        {
+#if defined(__GNUC__)
+            return 63 - __builtin_clzll(value);
+#else
+            unsigned bit = 0;
+            while (value >>= 1)
+            {
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+
+        static std::size_t bucketOf(std::uint64_t value)
+        {
+            if (value < SUB_BUCKETS)
+            {
+                return value;
+            }
+            const unsigned shift = highestBit(value) - SUB_BUCKET_BITS;
+            return ((shift + 1) << SUB_BUCKET_BITS) | ((value >> shift) & (SUB_BUCKETS - 1));
+        }
+
+        static std::uint64_t highestValueOf(std::size_t bucket)
+        {
+            if (bucket < SUB_BUCKETS)
+            {
+                return bucket;
+            }
+            const unsigned shift = (bucket >> SUB_BUCKET_BITS) - 1;
+            const std::uint64_t mantissa = (bucket & (SUB_BUCKETS - 1)) | SUB_BUCKETS;
+            return ((mantissa + 1) << shift) - 1;
+        }
+    };
+
+    inline std::uint64_t maxResidentKb()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    class Stopwatch
+    {
+    public:
+        Stopwatch() :
+            start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        std::uint64_t elapsed() const
+        {
+            const auto duration = std::chrono::steady_clock::now() - start_;
+            return std::chrono::duration_cast< std::chrono::nanoseconds >(duration).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Load phase timings and per-command latencies of the T3 engines, printed
+    // as one "stats key=value ..." line each, the format bench-t3 reads.
+    class StatsRegistry
+    {
+    public:
+        void recordPhase(const std::string& phase, std::uint64_t ns)
+        {
+            phases_.emplace_back(phase, ns);
+        }
+
+        void recordCommand(const std::string& command, std::uint64_t ns, bool failed)
+        {
+            CommandStats& entry = commands_[command];
+            entry.latency.record(ns);
+            if (failed)
+            {
+                ++entry.errors;
+            }
+        }
+
+        void print(std::ostream& out) const
+        {
+            for (const auto& phase : phases_)
+            {
+                out << "stats phase=" << phase.first << " ns=" << phase.second << '\n';
+            }
+            for (const auto& command : commands_)
+            {
+                const LatencyHistogram& latency = command.second.latency;
+                out << "stats command=" << command.first
+                    << " count=" << latency.count()
+                    << " errors=" << command.second.errors
+                    << " total_ns=" << latency.total()
+                    << " p50_ns=" << latency.percentile(50.0)
+                    << " p90_ns=" << latency.percentile(90.0)
+                    << " p99_ns=" << latency.percentile(99.0)
+                    << " p999_ns=" << latency.percentile(99.9)
+                    << " max_ns=" << latency.max() << '\n';
+            }
+            out << "stats memory max_rss_kb=" << maxResidentKb() << '\n';
+        }
+
+    private:
+        struct CommandStats
+        {
+            std::uint64_t errors = 0;
+            LatencyHistogram latency;
+        };
+
+        std::vector< std::pair< std::string, std::uint64_t > > phases_;
+        std::map< std::string, CommandStats > commands_;
+    };
+}
+
+#endif
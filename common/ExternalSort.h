@@ -0,0 +1,231 @@
+#ifndef COMMON_EXTERNAL_SORT_H
+#define COMMON_EXTERNAL_SORT_H
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace common
+{
+    namespace detail
+    {
+        const std::size_t NO_SOURCE = static_cast< std::size_t >(-1);
+    }
+
+    // Tournament tree over k sorted sources that keeps the loser of every
+    // match, so replacing the winner costs one comparison per level.
+    // less(a, b) must order two source indexes, exhausted ones last.
+    template < typename Less >
+    class LoserTree
+    {
+    public:
+        LoserTree(std::size_t sources, Less less) :
+            nodes_(std::max< std::size_t >(sources, 1), detail::NO_SOURCE),
+            sources_(sources),
+            less_(less)
+        {
+            for (std::size_t source = sources; source-- > 0;)
+            {
+                replay(source);
+            }
+        }
+
+        std::size_t winner() const
+        {
+            return nodes_[0];
+        }
+
+        // Replays the matches of source after its head changed.
+        void replay(std::size_t source)
+        {
+            std::size_t winner = source;
+            for (std::size_t node = (source + sources_) / 2; node > 0; node /= 2)
+            {
+                if (nodes_[node] == detail::NO_SOURCE)
+                {
+                    nodes_[node] = winner;
+                    return;
+                }
+                if (less_(nodes_[node], winner))
+                {
+                    std::swap(nodes_[node], winner);
+                }
+            }
+            nodes_[0] = winner;
+        }
+
+    private:
+        std::vector< std::size_t > nodes_;
+        std::size_t sources_;
+        Less less_;
+    };
+
+    // Sorts more records than fit in memory. Records are collected while their
+    // estimated footprint stays within the limit, then the run is sorted and
+    // spilled to a temporary file in Codec's binary encoding; finish() merges
+    // the runs with a loser tree. The estimate covers what the records own,
+    // the whole capacity of the array that holds them, the old array while it
+    // grows and the buffer stable_sort takes; after the first run the array is
+    // sized for the records a run is expected to hold. Codec provides
+    //     static void write(std::FILE*, const Record&);
+    //     static bool read(std::FILE*, Record&);
+    //     // Heap memory the record owns.
+    //     static std::size_t footprint(const Record&);
+    // Both the runs and the merge are stable, so equal records keep their input
+    // order.
+    template < typename Record, typename Codec, typename Compare >
+    class ExternalSorter
+    {
+    public:
+        ExternalSorter(std::size_t memoryLimit, Compare comp) :
+            memoryLimit_(memoryLimit),
+            heap_(0),
+            comp_(comp)
+        {
+        }
+
+        void push(Record record)
+        {
+            const std::size_t footprint = Codec::footprint(record);
+            if (!records_.empty()
+                && heap_ + footprint + arrayBytes(records_.size() + 1) > memoryLimit_)
+            {
+                spill();
+            }
+            heap_ += footprint;
+            records_.push_back(std::move(record));
+        }
+
+        // Calls output(record) for every record in order. Without spilled runs
+        // this is an ordinary in-memory sort.
+        template < typename Output >
+        void finish(Output output)
+        {
+            if (runs_.empty())
+            {
+                std::stable_sort(records_.begin(), records_.end(), comp_);
+                for (const Record& record : records_)
+                {
+                    output(record);
+                }
+                return;
+            }
+            if (!records_.empty())
+            {
+                spill();
+            }
+            std::vector< Record >().swap(records_);
+            merge(output);
+        }
+
+    private:
+        struct FileCloser
+        {
+            void operator()(std::FILE* file) const
+            {
+                std::fclose(file);
+            }
+        };
+        using File = std::unique_ptr< std::FILE, FileCloser >;
+
+        static const std::size_t RUN_BUFFER_SIZE = 1 << 16;
+
+        std::size_t memoryLimit_;
+        // What the collected records own, not counting the array.
+        std::size_t heap_;
+        Compare comp_;
+        std::vector< Record > records_;
+        std::vector< File > runs_;
+
+        void spill()
+        {
+            std::stable_sort(records_.begin(), records_.end(), comp_);
+            File run(std::tmpfile());
+            if (!run)
+            {
+                throw std::runtime_error("could not create a temporary file for a sort run");
+            }
+            std::setvbuf(run.get(), nullptr, _IOFBF, RUN_BUFFER_SIZE);
+            for (const Record& record : records_)
+            {
+                Codec::write(run.get(), record);
+            }
+            if (std::fflush(run.get()) != 0 || std::ferror(run.get()))
+            {
+                throw std::runtime_error("could not write a sort run");
+            }
+            runs_.push_back(std::move(run));
+
+            // Sizes the array for a run of records like these, so that it
+            // does not grow by doubling past what the limit needs.
+            const std::size_t perRecord = heap_ / records_.size() + sizeof(Record) * 3 / 2;
+            const std::size_t expected = memoryLimit_ / perRecord;
+            if (expected > records_.capacity())
+            {
+                std::vector< Record >().swap(records_);
+                records_.reserve(expected);
+            }
+            records_.clear();
+            heap_ = 0;
+        }
+
+        // Bytes of the array once it holds count records: its capacity and,
+        // while it grows, the old array the records are moved from, or else
+        // the buffer of count / 2 records stable_sort takes.
+        std::size_t arrayBytes(std::size_t count) const
+        {
+            const std::size_t capacity = records_.capacity();
+            if (count <= capacity)
+            {
+                return (capacity + count / 2) * sizeof(Record);
+            }
+            return (std::max(count, 2 * capacity) + capacity) * sizeof(Record);
+        }
+
+        template < typename Output >
+        void merge(Output output)
+        {
+            const std::size_t count = runs_.size();
+            std::vector< Record > heads(count);
+            std::vector< bool > exhausted(count, false);
+            for (std::size_t run = 0; run < count; ++run)
+            {
+                std::rewind(runs_[run].get());
+                exhausted[run] = !Codec::read(runs_[run].get(), heads[run]);
+            }
+            // Ties go to the earlier run, which keeps the merge stable.
+            auto less = [&](std::size_t left, std::size_t right)
+            {
+                if (exhausted[left] || exhausted[right])
+                {
+                    return !exhausted[left];
+                }
+                if (comp_(heads[left], heads[right]))
+                {
+                    return true;
+                }
+                return !comp_(heads[right], heads[left]) && left < right;
+            };
+            LoserTree< decltype(less) > tree(count, less);
+            while (!exhausted[tree.winner()])
+            {
+                std::size_t run = tree.winner();
+                output(heads[run]);
+                exhausted[run] = !Codec::read(runs_[run].get(), heads[run]);
+                tree.replay(run);
+            }
+            for (const File& run : runs_)
+            {
+                if (std::ferror(run.get()))
+                {
+                    throw std::runtime_error("could not read a sort run");
+                }
+            }
+            runs_.clear();
+        }
+    };
+}
+
+#endif
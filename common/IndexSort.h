@@ -0,0 +1,80 @@
+#ifndef COMMON_INDEX_SORT_H
+#define COMMON_INDEX_SORT_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "ParallelSort.h"
+
+namespace common
+{
+    namespace detail
+    {
+        template < typename Key >
+        struct KeyedIndex
+        {
+            Key key;
+            std::uint32_t index;
+        };
+
+        template < typename T >
+        void checkIndexable(const std::vector< T >& data)
+        {
+            if (data.size() > std::numeric_limits< std::uint32_t >::max())
+            {
+                throw std::length_error("too many records for 32-bit indices");
+            }
+        }
+    }
+
+    // Positions of the records of data in the order of a stable sort by comp.
+    // Only the 32-bit indices are moved, however heavy the records are.
+    template < typename T, typename Compare >
+    std::vector< std::uint32_t > sortedIndices(const std::vector< T >& data, Compare comp)
+    {
+        detail::checkIndexable(data);
+        std::vector< std::uint32_t > order(data.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = static_cast< std::uint32_t >(i);
+        }
+        parallelSort(order.begin(), order.end(),
+            [&data, &comp](std::uint32_t left, std::uint32_t right)
+            {
+                return comp(data[left], data[right]);
+            });
+        return order;
+    }
+
+    // Same, but keyOf(record) is computed once per record and stored next to
+    // its index, so comparisons read neither the records nor whatever they
+    // point to. comp orders keys.
+    template < typename T, typename KeyOf, typename Compare >
+    std::vector< std::uint32_t > sortedIndices(const std::vector< T >& data, KeyOf keyOf,
+        Compare comp)
+    {
+        using Key = decltype(keyOf(data.front()));
+        detail::checkIndexable(data);
+        std::vector< detail::KeyedIndex< Key > > keyed;
+        keyed.reserve(data.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            keyed.push_back({ keyOf(data[i]), static_cast< std::uint32_t >(i) });
+        }
+        parallelSort(keyed.begin(), keyed.end(),
+            [&comp](const detail::KeyedIndex< Key >& left, const detail::KeyedIndex< Key >& right)
+            {
+                return comp(left.key, right.key);
+            });
+        std::vector< std::uint32_t > order(keyed.size());
+        for (std::size_t i = 0; i < keyed.size(); ++i)
+        {
+            order[i] = keyed[i].index;
+        }
+        return order;
+    }
+}
+
+#endif
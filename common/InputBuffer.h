@@ -0,0 +1,131 @@
+#ifndef COMMON_INPUT_BUFFER_H
+#define COMMON_INPUT_BUFFER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common
+{
+    // The rest of the input of a file descriptor, as one contiguous range.
+    // A regular file is mapped from the current offset on, so nothing is
+    // copied and pages are only read as a parser gets to them; a pipe or a
+    // terminal is read in blocks of BLOCK_SIZE straight into the buffer,
+    // without a stream in between. Either way the descriptor is left at the
+    // end of the input.
+    class InputBuffer
+    {
+    public:
+        static const std::size_t BLOCK_SIZE = 1 << 20;
+
+        explicit InputBuffer(int fd) :
+            data_(""),
+            size_(0),
+            mapping_(nullptr),
+            mappingSize_(0)
+        {
+            if (!map(fd))
+            {
+                read(fd);
+            }
+        }
+
+        InputBuffer(const InputBuffer&) = delete;
+        InputBuffer& operator=(const InputBuffer&) = delete;
+
+        ~InputBuffer()
+        {
+            if (mapping_)
+            {
+                munmap(mapping_, mappingSize_);
+            }
+        }
+
+        const char* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+    private:
+        const char* data_;
+        std::size_t size_;
+        void* mapping_;
+        std::size_t mappingSize_;
+        std::vector< char > buffer_;
+
+        bool map(int fd)
+        {
+            struct stat info;
+            if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+            {
+                return false;
+            }
+            const off_t offset = lseek(fd, 0, SEEK_CUR);
+            if (offset < 0 || offset > info.st_size)
+            {
+                return false;
+            }
+            if (offset == info.st_size)
+            {
+                return true;
+            }
+            const std::size_t size = static_cast< std::size_t >(info.st_size);
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                return false;
+            }
+            posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+            mapping_ = mapping;
+            mappingSize_ = size;
+            data_ = static_cast< const char* >(mapping) + offset;
+            size_ = size - static_cast< std::size_t >(offset);
+            lseek(fd, 0, SEEK_END);
+            return true;
+        }
+
+        void read(int fd)
+        {
+            std::size_t size = 0;
+            while (true)
+            {
+                if (buffer_.size() < size + BLOCK_SIZE)
+                {
+                    buffer_.resize(std::max(buffer_.size() * 2, size + BLOCK_SIZE));
+                }
+                const ssize_t count = ::read(fd, buffer_.data() + size, BLOCK_SIZE);
+                if (count < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "cannot read input");
+                }
+                if (count == 0)
+                {
+                    break;
+                }
+                size += static_cast< std::size_t >(count);
+            }
+            if (size != 0)
+            {
+                data_ = buffer_.data();
+                size_ = size;
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,495 @@
+#ifndef COMMON_NUMBER_CODEC_H
+#define COMMON_NUMBER_CODEC_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace common
+{
+    // Outcome of a parse in the manner of std::from_chars: ptr is the first
+    // character not consumed, ok tells whether a value was stored.
+    struct ParseResult
+    {
+        const char* ptr;
+        bool ok;
+    };
+
+    // Large enough for any integer formatInteger writes.
+    const std::size_t INTEGER_BUFFER_SIZE = 72;
+    // Large enough for any finite double formatFixed writes with precision up
+    // to MAX_FIXED_PRECISION.
+    const std::size_t FIXED_BUFFER_SIZE = 400;
+    const int MAX_FIXED_PRECISION = 17;
+
+    namespace detail
+    {
+        const double EXACT_POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        const int MAX_EXACT_POWER = 22;
+        const std::uint64_t MAX_EXACT_MANTISSA = std::uint64_t(1) << 53;
+        const int MAX_MANTISSA_DIGITS = 19;
+
+        inline int digitValue(char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'z')
+            {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'Z')
+            {
+                return c - 'A' + 10;
+            }
+            return 36;
+        }
+
+        inline bool isDecimal(const char* pos, const char* last)
+        {
+            return pos != last && *pos >= '0' && *pos <= '9';
+        }
+
+        struct PointerCursor
+        {
+            const char* pos;
+            const char* last;
+
+            bool atEnd() const
+            {
+                return pos == last;
+            }
+
+            char peek() const
+            {
+                return *pos;
+            }
+
+            void advance()
+            {
+                ++pos;
+            }
+        };
+
+        // Characters of a stream buffer; the ones taken are collected in text.
+        class StreamCursor
+        {
+        public:
+            explicit StreamCursor(std::streambuf* buffer) :
+                buffer_(buffer),
+                current_(buffer->sgetc())
+            {
+            }
+
+            bool atEnd() const
+            {
+                return current_ == std::char_traits< char >::eof();
+            }
+
+            char peek() const
+            {
+                return std::char_traits< char >::to_char_type(current_);
+            }
+
+            void advance()
+            {
+                text += peek();
+                current_ = buffer_->snextc();
+            }
+
+            std::string text;
+
+        private:
+            std::streambuf* buffer_;
+            int current_;
+        };
+
+        template < typename Cursor >
+        void skipSign(Cursor& cursor)
+        {
+            if (!cursor.atEnd() && (cursor.peek() == '+' || cursor.peek() == '-'))
+            {
+                cursor.advance();
+            }
+        }
+
+        // Characters std::num_get takes for an integer: a sign, a "0x" prefix
+        // in base 16, then digits valid in the base.
+        template < typename Cursor >
+        void skipInteger(Cursor& cursor, unsigned base)
+        {
+            skipSign(cursor);
+            if (base == 16 && !cursor.atEnd() && cursor.peek() == '0')
+            {
+                cursor.advance();
+                if (!cursor.atEnd() && (cursor.peek() == 'x' || cursor.peek() == 'X'))
+                {
+                    cursor.advance();
+                }
+            }
+            while (!cursor.atEnd() && static_cast< unsigned >(digitValue(cursor.peek())) < base)
+            {
+                cursor.advance();
+            }
+        }
+
+        // Characters std::num_get takes for a double in the "C" locale: a sign,
+        // digits with one '.', and an 'e' once there are digits, optionally
+        // followed by a sign. Whether they form a number is decided later.
+        template < typename Cursor >
+        void skipFloat(Cursor& cursor)
+        {
+            skipSign(cursor);
+            bool mantissa = false;
+            bool decimal = false;
+            bool exponent = false;
+            while (!cursor.atEnd())
+            {
+                const char c = cursor.peek();
+                if (c >= '0' && c <= '9')
+                {
+                    mantissa = true;
+                }
+                else if (c == '.' && !decimal && !exponent)
+                {
+                    decimal = true;
+                }
+                else if ((c == 'e' || c == 'E') && !exponent && mantissa)
+                {
+                    exponent = true;
+                    cursor.advance();
+                    skipSign(cursor);
+                    continue;
+                }
+                else
+                {
+                    break;
+                }
+                cursor.advance();
+            }
+        }
+
+        template < typename Unsigned >
+        char* formatUnsigned(char* first, Unsigned value, unsigned base)
+        {
+            static const char DIGITS[] = "0123456789ABCDEF";
+            char reversed[INTEGER_BUFFER_SIZE];
+            std::size_t length = 0;
+            do
+            {
+                reversed[length++] = DIGITS[value % base];
+                value /= base;
+            }
+            while (value != 0);
+            while (length > 0)
+            {
+                *first++ = reversed[--length];
+            }
+            return first;
+        }
+    }
+
+    // Integer in the given base, as std::num_get reads it with the matching
+    // basefield: an optional sign, then every digit valid in the base. The
+    // parse fails without digits or when the value is out of range; a minus
+    // sign wraps unsigned values. In base 16 a "0x" or "0X" prefix is skipped.
+    template < typename T >
+    ParseResult parseInteger(const char* first, const char* last, T& value, unsigned base = 10)
+    {
+        using Unsigned = typename std::make_unsigned< T >::type;
+        const char* pos = first;
+        bool negative = pos != last && *pos == '-';
+        if (pos != last && (*pos == '-' || *pos == '+'))
+        {
+            ++pos;
+        }
+        if (base == 16 && last - pos >= 2 && pos[0] == '0' && (pos[1] == 'x' || pos[1] == 'X'))
+        {
+            pos += 2;
+        }
+        const Unsigned max = (negative && std::is_signed< T >::value) ?
+            static_cast< Unsigned >(std::numeric_limits< T >::max()) + 1 :
+            static_cast< Unsigned >(std::numeric_limits< T >::max());
+        Unsigned result = 0;
+        bool found = false;
+        bool overflow = false;
+        for (; pos != last; ++pos)
+        {
+            const unsigned digit = detail::digitValue(*pos);
+            if (digit >= base)
+            {
+                break;
+            }
+            found = true;
+            if (result > (max - digit) / base)
+            {
+                overflow = true;
+            }
+            else
+            {
+                result = result * base + digit;
+            }
+        }
+        if (!found || overflow)
+        {
+            return ParseResult{ pos, false };
+        }
+        value = static_cast< T >(negative ? Unsigned(0) - result : result);
+        return ParseResult{ pos, true };
+    }
+
+    // Decimal floating-point literal: an optional sign, digits with at most
+    // one '.', then an exponent if 'e' or 'E' is followed by digits. The value
+    // is correctly rounded; a value too large for a double fails. Up to 19
+    // significant digits with a small exponent are converted exactly with one
+    // rounding, anything else falls back to std::strtod, which rounds
+    // correctly and sees the "C" locale as long as setlocale is not called.
+    inline ParseResult parseDouble(const char* first, const char* last, double& value)
+    {
+        const char* pos = first;
+        bool negative = pos != last && *pos == '-';
+        if (pos != last && (*pos == '-' || *pos == '+'))
+        {
+            ++pos;
+        }
+        std::uint64_t mantissa = 0;
+        int digits = 0;
+        long exponent = 0;
+        bool found = false;
+        bool truncated = false;
+        bool fraction = false;
+        for (; pos != last; ++pos)
+        {
+            if (*pos == '.' && !fraction)
+            {
+                fraction = true;
+                continue;
+            }
+            if (*pos < '0' || *pos > '9')
+            {
+                break;
+            }
+            found = true;
+            const int digit = *pos - '0';
+            if (mantissa == 0 && digit == 0)
+            {
+                exponent -= fraction;
+            }
+            else if (digits < detail::MAX_MANTISSA_DIGITS)
+            {
+                mantissa = mantissa * 10 + digit;
+                ++digits;
+                exponent -= fraction;
+            }
+            else
+            {
+                truncated |= digit != 0;
+                exponent += !fraction;
+            }
+        }
+        if (!found)
+        {
+            return ParseResult{ first, false };
+        }
+        if (pos != last && (*pos == 'e' || *pos == 'E'))
+        {
+            const char* mark = pos + 1;
+            bool negativeExponent = mark != last && *mark == '-';
+            if (mark != last && (*mark == '-' || *mark == '+'))
+            {
+                ++mark;
+            }
+            if (detail::isDecimal(mark, last))
+            {
+                long written = 0;
+                for (; detail::isDecimal(mark, last); ++mark)
+                {
+                    written = std::min(written * 10 + (*mark - '0'), 100000L);
+                }
+                exponent += negativeExponent ? -written : written;
+                pos = mark;
+            }
+        }
+
+        if (!truncated && mantissa <= detail::MAX_EXACT_MANTISSA
+            && exponent >= -detail::MAX_EXACT_POWER && exponent <= detail::MAX_EXACT_POWER)
+        {
+            double result = static_cast< double >(mantissa);
+            if (exponent < 0)
+            {
+                result /= detail::EXACT_POWERS_OF_TEN[-exponent];
+            }
+            else
+            {
+                result *= detail::EXACT_POWERS_OF_TEN[exponent];
+            }
+            value = negative ? -result : result;
+            return ParseResult{ pos, true };
+        }
+        const std::string literal(first, pos);
+        char* end = nullptr;
+        double result = std::strtod(literal.c_str(), &end);
+        if (end != literal.c_str() + literal.size() || std::isinf(result))
+        {
+            return ParseResult{ pos, false };
+        }
+        value = result;
+        return ParseResult{ pos, true };
+    }
+
+    // End of the characters std::num_get consumes for a double from first in
+    // the "C" locale; they are a valid number if parseDouble takes them all.
+    inline const char* scanFloat(const char* first, const char* last)
+    {
+        detail::PointerCursor cursor{ first, last };
+        detail::skipFloat(cursor);
+        return cursor.pos;
+    }
+
+    // Same as in >> value with the basefield set to base, including the
+    // stream state it leaves, but without the locale machinery. On failure
+    // value is left alone.
+    template < typename T >
+    std::istream& readInteger(std::istream& in, T& value, unsigned base = 10)
+    {
+        std::istream::sentry sentry(in);
+        if (!sentry)
+        {
+            return in;
+        }
+        detail::StreamCursor cursor(in.rdbuf());
+        detail::skipInteger(cursor, base);
+        std::ios::iostate state = cursor.atEnd() ? std::ios::eofbit : std::ios::goodbit;
+        const char* text = cursor.text.data();
+        if (!parseInteger(text, text + cursor.text.size(), value, base).ok)
+        {
+            state |= std::ios::failbit;
+        }
+        in.setstate(state);
+        return in;
+    }
+
+    // Same as in >> value for a double.
+    inline std::istream& readDouble(std::istream& in, double& value)
+    {
+        std::istream::sentry sentry(in);
+        if (!sentry)
+        {
+            return in;
+        }
+        detail::StreamCursor cursor(in.rdbuf());
+        detail::skipFloat(cursor);
+        std::ios::iostate state = cursor.atEnd() ? std::ios::eofbit : std::ios::goodbit;
+        const char* text = cursor.text.data();
+        const char* end = text + cursor.text.size();
+        double result = 0;
+        ParseResult parsed = parseDouble(text, end, result);
+        if (parsed.ok && parsed.ptr == end)
+        {
+            value = result;
+        }
+        else
+        {
+            state |= std::ios::failbit;
+        }
+        in.setstate(state);
+        return in;
+    }
+
+    // Writes value in the given base, digits above 9 in upper case, with a
+    // minus sign for negative values; returns the end of the text.
+    template < typename T >
+    char* formatInteger(char* first, T value, unsigned base = 10)
+    {
+        using Unsigned = typename std::make_unsigned< T >::type;
+        Unsigned magnitude = static_cast< Unsigned >(value);
+        if (value < 0)
+        {
+            *first++ = '-';
+            magnitude = Unsigned(0) - magnitude;
+        }
+        return detail::formatUnsigned(first, magnitude, base);
+    }
+
+    // Writes value like printf("%.*f", precision, value) in the "C" locale,
+    // for precision from 0 to MAX_FIXED_PRECISION:
+    // the exact binary value rounded half to even. Values below 2^52 with up
+    // to 9 decimals are done with integer arithmetic, the fractional digits
+    // rounded exactly by means of fused multiply-adds; anything else goes
+    // through snprintf. Returns the end of the text.
+    inline char* formatFixed(char* first, double value, int precision)
+    {
+        const double limit = 4503599627370496.0;
+        if (!(std::fabs(value) < limit) || precision > 9)
+        {
+            int length = std::snprintf(first, FIXED_BUFFER_SIZE, "%.*f", precision, value);
+            return first + length;
+        }
+        if (std::signbit(value))
+        {
+            *first++ = '-';
+            value = -value;
+        }
+        std::uint64_t integer = static_cast< std::uint64_t >(value);
+        const double fraction = value - static_cast< double >(integer);
+        const double scale = detail::EXACT_POWERS_OF_TEN[precision];
+        std::uint64_t digits = static_cast< std::uint64_t >(fraction * scale);
+        const double low = static_cast< double >(digits);
+        if (std::fma(fraction, scale, -low) < 0)
+        {
+            --digits;
+        }
+        else if (std::fma(fraction, scale, -(low + 1)) >= 0)
+        {
+            ++digits;
+        }
+        const double half = std::fma(fraction, scale, -(static_cast< double >(digits) + 0.5));
+        const bool odd = (precision > 0 ? digits : integer) % 2 == 1;
+        if (half > 0 || (half == 0 && odd))
+        {
+            ++digits;
+        }
+        if (digits == static_cast< std::uint64_t >(scale))
+        {
+            digits = 0;
+            ++integer;
+        }
+        first = detail::formatUnsigned(first, integer, 10);
+        if (precision > 0)
+        {
+            *first++ = '.';
+            for (int i = precision - 1; i >= 0; --i)
+            {
+                first[i] = static_cast< char >('0' + digits % 10);
+                digits /= 10;
+            }
+            first += precision;
+        }
+        return first;
+    }
+
+    template < typename T >
+    std::ostream& writeInteger(std::ostream& out, T value, unsigned base = 10)
+    {
+        char buffer[INTEGER_BUFFER_SIZE];
+        return out.write(buffer, formatInteger(buffer, value, base) - buffer);
+    }
+
+    inline std::ostream& writeFixed(std::ostream& out, double value, int precision)
+    {
+        char buffer[FIXED_BUFFER_SIZE];
+        return out.write(buffer, formatFixed(buffer, value, precision) - buffer);
+    }
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef COMMON_PARALLEL_SCAN_H
+#define COMMON_PARALLEL_SCAN_H
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ParallelSort.h"
+#include "TextCursor.h"
+
+namespace common
+{
+    namespace detail
+    {
+        // Smallest share of the input worth a thread of its own.
+        const std::size_t PARALLEL_SCAN_GRAIN = 1 << 20;
+        // Attempts remembered at the start of a chunk to meet the previous
+        // chunk at; after that many the chunk is scanned again.
+        const std::size_t SYNC_ATTEMPTS = 64;
+
+        // Just after the first ":)" from pos that is followed by whitespace,
+        // where a record most likely ended, or end.
+        inline const char* recordBoundary(const char* pos, const char* end)
+        {
+            while (pos != end)
+            {
+                const void* found = std::memchr(pos, ':', end - pos);
+                if (!found)
+                {
+                    return end;
+                }
+                const char* colon = static_cast< const char* >(found);
+                if (end - colon >= 3 && colon[1] == ')' && isSpace(colon[2]))
+                {
+                    return colon + 2;
+                }
+                pos = colon + 1;
+            }
+            return end;
+        }
+
+        template < typename Record >
+        struct ScannedChunk
+        {
+            std::vector< Record > records;
+            // Where each of the first attempts started and how many records
+            // the chunk had before it.
+            std::vector< std::pair< const char*, std::size_t > > starts;
+            // Start of the first attempt at or after the end of the chunk, or
+            // the end of the input once the scanner has run out of it.
+            const char* exit;
+        };
+
+        // Scans from from, reading on into the rest of the input as needed,
+        // until an attempt would start at or after to.
+        template < typename Record, typename Scanner >
+        void scanChunk(const char* from, const char* to, const char* end,
+            ScannedChunk< Record >& chunk)
+        {
+            Scanner scanner(from, end);
+            Record record{};
+            while (scanner.position() < to)
+            {
+                if (chunk.starts.size() < SYNC_ATTEMPTS)
+                {
+                    chunk.starts.emplace_back(scanner.position(), chunk.records.size());
+                }
+                typename Scanner::Status status = scanner.next(record);
+                if (status == Scanner::RECORD)
+                {
+                    chunk.records.push_back(record);
+                }
+                else if (status == Scanner::END)
+                {
+                    chunk.exit = end;
+                    return;
+                }
+            }
+            chunk.exit = scanner.position();
+        }
+    }
+
+    // The records a Scanner reads from [begin, end), in input order, scanned
+    // in chunks on up to threads threads (0 means one per hardware thread).
+    //
+    // Chunks are cut after a ":)" and whitespace, which may as well be inside
+    // a quoted string or a rejected record, so a chunk is only trusted from
+    // the point where the scan of the previous chunk arrives at one of its own
+    // attempts: from there on both see the same characters from the same
+    // place. A chunk the previous scan does not meet early is scanned again
+    // from where that scan stopped, so the records are always the same as
+    // from a single Scanner. A Scanner is constructed from a range and has
+    // Status next(Record&), returning RECORD, REJECTED or END, and position().
+    template < typename Record, typename Scanner >
+    std::vector< Record > parallelScan(const char* begin, const char* end,
+        std::size_t threads = 0)
+    {
+        const std::size_t size = end - begin;
+        if (threads == 0)
+        {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        threads = std::max< std::size_t >(std::min(threads,
+            size / detail::PARALLEL_SCAN_GRAIN), 1);
+        std::vector< const char* > bounds(threads + 1, end);
+        bounds[0] = begin;
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            bounds[i] = std::max(bounds[i - 1],
+                detail::recordBoundary(begin + size * i / threads, end));
+        }
+        std::vector< detail::ScannedChunk< Record > > chunks(threads);
+        detail::runParallel(threads, [&](std::size_t i)
+        {
+            detail::scanChunk< Record, Scanner >(bounds[i], bounds[i + 1], end, chunks[i]);
+        });
+
+        std::size_t total = 0;
+        for (const auto& chunk : chunks)
+        {
+            total += chunk.records.size();
+        }
+        std::vector< Record > records = std::move(chunks[0].records);
+        records.reserve(total);
+        const char* pos = chunks[0].exit;
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            if (pos >= bounds[i + 1])
+            {
+                continue;
+            }
+            detail::ScannedChunk< Record >& chunk = chunks[i];
+            auto start = std::find_if(chunk.starts.begin(), chunk.starts.end(),
+                [pos](const std::pair< const char*, std::size_t >& attempt)
+                {
+                    return attempt.first == pos;
+                });
+            std::size_t first = 0;
+            if (start != chunk.starts.end())
+            {
+                first = start->second;
+            }
+            else
+            {
+                chunk = detail::ScannedChunk< Record >();
+                detail::scanChunk< Record, Scanner >(pos, bounds[i + 1], end, chunk);
+            }
+            records.insert(records.end(),
+                std::make_move_iterator(chunk.records.begin() + first),
+                std::make_move_iterator(chunk.records.end()));
+            pos = chunk.exit;
+        }
+        return records;
+    }
+}
+
+#endif
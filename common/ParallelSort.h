@@ -0,0 +1,167 @@
+#ifndef COMMON_PARALLEL_SORT_H
+#define COMMON_PARALLEL_SORT_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+    namespace detail
+    {
+        // Smallest share of the elements worth a thread of its own.
+        const std::size_t PARALLEL_SORT_GRAIN = 1 << 15;
+
+        // Calls task(0) ... task(count - 1), each on its own thread where one
+        // can be started, and waits for all of them.
+        template < typename Task >
+        void runParallel(std::size_t count, Task task)
+        {
+            std::vector< std::thread > threads;
+            threads.reserve(count);
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                try
+                {
+                    threads.emplace_back(task, i);
+                }
+                catch (const std::system_error&)
+                {
+                    task(i);
+                }
+            }
+            task(0);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        // Number of elements taken from a when the stable merge of sorted a and
+        // b has produced k elements; ties go to a.
+        template < typename It, typename Compare >
+        std::size_t coRank(std::size_t k, It a, std::size_t aSize, It b, std::size_t bSize,
+            Compare comp)
+        {
+            std::size_t low = k > bSize ? k - bSize : 0;
+            std::size_t high = std::min(k, aSize);
+            while (low < high)
+            {
+                std::size_t i = low + (high - low) / 2;
+                if (!comp(b[k - i - 1], a[i]))
+                {
+                    low = i + 1;
+                }
+                else
+                {
+                    high = i;
+                }
+            }
+            return low;
+        }
+
+        // Merges neighbouring groups of width sorted runs from src into dst. The
+        // output is cut into one equal slice per thread, and every slice merges
+        // its part of each pair of groups independently.
+        template < typename In, typename Out, typename Compare >
+        void mergeRound(In src, Out dst, const std::vector< std::size_t >& bounds,
+            std::size_t width, std::size_t threads, Compare comp)
+        {
+            const std::size_t runs = bounds.size() - 1;
+            const std::size_t size = bounds.back();
+            runParallel(threads, [&](std::size_t thread)
+            {
+                const std::size_t from = size * thread / threads;
+                const std::size_t to = size * (thread + 1) / threads;
+                for (std::size_t run = 0; run < runs; run += 2 * width)
+                {
+                    const std::size_t low = bounds[run];
+                    const std::size_t middle = bounds[std::min(run + width, runs)];
+                    const std::size_t high = bounds[std::min(run + 2 * width, runs)];
+                    if (high <= from || low >= to)
+                    {
+                        continue;
+                    }
+                    const std::size_t first = std::max(from, low) - low;
+                    const std::size_t last = std::min(to, high) - low;
+                    const std::size_t aSize = middle - low;
+                    const std::size_t bSize = high - middle;
+                    std::size_t aFirst = coRank(first, src + low, aSize, src + middle, bSize, comp);
+                    std::size_t aLast = coRank(last, src + low, aSize, src + middle, bSize, comp);
+                    std::merge(std::make_move_iterator(src + low + aFirst),
+                        std::make_move_iterator(src + low + aLast),
+                        std::make_move_iterator(src + middle + first - aFirst),
+                        std::make_move_iterator(src + middle + last - aLast),
+                        dst + low + first, comp);
+                }
+            });
+        }
+    }
+
+    // Stable sort of [first, last) on up to threads threads (0 means one per
+    // hardware thread): runs are sorted with std::stable_sort in parallel and
+    // then merged pairwise, each round split evenly between the threads. The
+    // result does not depend on the number of threads, and for a strict weak
+    // order it is one of the orders std::sort may produce.
+    template < typename RandomIt, typename Compare >
+    void parallelSort(RandomIt first, RandomIt last, Compare comp, std::size_t threads = 0)
+    {
+        using Value = typename std::iterator_traits< RandomIt >::value_type;
+        const std::size_t size = last - first;
+        if (threads == 0)
+        {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        threads = std::min(threads, size / detail::PARALLEL_SORT_GRAIN);
+        if (threads < 2)
+        {
+            std::stable_sort(first, last, comp);
+            return;
+        }
+
+        std::vector< std::size_t > bounds(threads + 1);
+        for (std::size_t run = 0; run <= threads; ++run)
+        {
+            bounds[run] = size * run / threads;
+        }
+        detail::runParallel(threads, [&](std::size_t run)
+        {
+            std::stable_sort(first + bounds[run], first + bounds[run + 1], comp);
+        });
+
+        std::vector< Value > buffer(size);
+        bool inBuffer = false;
+        for (std::size_t width = 1; width < threads; width *= 2)
+        {
+            if (inBuffer)
+            {
+                detail::mergeRound(buffer.begin(), first, bounds, width, threads, comp);
+            }
+            else
+            {
+                detail::mergeRound(first, buffer.begin(), bounds, width, threads, comp);
+            }
+            inBuffer = !inBuffer;
+        }
+        if (inBuffer)
+        {
+            detail::runParallel(threads, [&](std::size_t thread)
+            {
+                std::move(buffer.begin() + bounds[thread], buffer.begin() + bounds[thread + 1],
+                    first + bounds[thread]);
+            });
+        }
+    }
+
+    template < typename RandomIt >
+    void parallelSort(RandomIt first, RandomIt last)
+    {
+        using Value = typename std::iterator_traits< RandomIt >::value_type;
+        parallelSort(first, last, std::less< Value >());
+    }
+}
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef COMMON_PARSE_TELEMETRY_H
+#define COMMON_PARSE_TELEMETRY_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "TextCursor.h"
+
+namespace common
+{
+    // Rejected records counted by reason, with a sample of the records of
+    // every reason. Reservoir sampling keeps SAMPLES of them, each record of
+    // the reason equally likely to be kept, so a rejection costs a counter,
+    // a random number and now and then a copy of SAMPLE_LENGTH characters.
+    class ParseTelemetry
+    {
+    public:
+        static const std::size_t SAMPLES = 4;
+        static const std::size_t SAMPLE_LENGTH = 80;
+
+        ParseTelemetry() :
+            counts_(),
+            state_(0x9e3779b97f4a7c15ULL)
+        {
+        }
+
+        // The record from begin was rejected for error at failure; end is
+        // the end of the text the record is in.
+        void reject(ParseError error, const char* begin, const char* failure, const char* end)
+        {
+            const std::size_t reason = static_cast< std::size_t >(error);
+            const std::uint64_t seen = ++counts_[reason];
+            std::vector< Sample >& samples = samples_[reason];
+            std::size_t slot = samples.size();
+            if (slot == SAMPLES)
+            {
+                slot = static_cast< std::size_t >(random() % seen);
+                if (slot >= SAMPLES)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                samples.emplace_back();
+            }
+            std::size_t length = end - begin;
+            if (length > SAMPLE_LENGTH)
+            {
+                length = SAMPLE_LENGTH;
+            }
+            samples[slot] = Sample{ std::string(begin, length),
+                static_cast< std::size_t >(failure - begin), seen };
+        }
+
+        std::uint64_t count(ParseError error) const
+        {
+            return counts_[static_cast< std::size_t >(error)];
+        }
+
+        // A line "rejects reason=NAME count=N" per reason that occurred, then
+        // a line "reject reason=NAME index=I column=C text=TEXT" per sample:
+        // the sample is the I-th record rejected for the reason and failed at
+        // character C of it; the text is its first SAMPLE_LENGTH characters,
+        // with line breaks and tabs escaped.
+        void report(std::ostream& out) const
+        {
+            for (std::size_t reason = 0; reason < PARSE_ERRORS; ++reason)
+            {
+                if (counts_[reason] != 0)
+                {
+                    out << "rejects reason=" << parseErrorName(static_cast< ParseError >(reason))
+                        << " count=" << counts_[reason] << '\n';
+                }
+            }
+            for (std::size_t reason = 0; reason < PARSE_ERRORS; ++reason)
+            {
+                for (const Sample& sample : samples_[reason])
+                {
+                    out << "reject reason=" << parseErrorName(static_cast< ParseError >(reason))
+                        << " index=" << sample.index << " column=" << sample.column << " text=";
+                    writeEscaped(out, sample.text);
+                    out << '\n';
+                }
+            }
+        }
+
+    private:
+        struct Sample
+        {
+            std::string text;
+            std::size_t column;
+            std::uint64_t index;
+        };
+
+        std::uint64_t counts_[PARSE_ERRORS];
+        std::vector< Sample > samples_[PARSE_ERRORS];
+        std::uint64_t state_;
+
+        // xorshift64
+        std::uint64_t random()
+        {
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 7;
+            state_ ^= state_ << 17;
+            return state_;
+        }
+
+        static void writeEscaped(std::ostream& out, const std::string& text)
+        {
+            for (char c : text)
+            {
+                if (c == '\n')
+                {
+                    out << "\\n";
+                }
+                else if (c == '\r')
+                {
+                    out << "\\r";
+                }
+                else if (c == '\t')
+                {
+                    out << "\\t";
+                }
+                else if (c == '\\')
+                {
+                    out << "\\\\";
+                }
+                else
+                {
+                    out << c;
+                }
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef COMMON_PHASE_STATS_H
+#define COMMON_PHASE_STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace common
+{
+    // Wall time of the phases of a run, for the bench tools. Nothing is
+    // measured unless one of the arguments is --stats; then finish() writes
+    // a line "stats phase=NAME ns=N" per phase and "stats max_rss_kb=N" to
+    // stderr, the way the T3 engines report.
+    class PhaseStats
+    {
+    public:
+        PhaseStats(int argc, char* argv[]) :
+            enabled_(false),
+            current_(nullptr)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                enabled_ = enabled_ || std::strcmp(argv[i], "--stats") == 0;
+            }
+        }
+
+        // Ends the current phase, if any, and starts the one called name.
+        void start(const char* name)
+        {
+            if (!enabled_)
+            {
+                return;
+            }
+            const Clock::time_point now = Clock::now();
+            end(now);
+            current_ = name;
+            started_ = now;
+        }
+
+        // Ends the last phase and reports. Output the phase wrote has to be
+        // flushed before, or it is not part of the phase.
+        void finish()
+        {
+            if (!enabled_)
+            {
+                return;
+            }
+            end(Clock::now());
+            for (const auto& phase : phases_)
+            {
+                std::cerr << "stats phase=" << phase.first << " ns=" << phase.second << '\n';
+            }
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            std::cerr << "stats max_rss_kb=" << usage.ru_maxrss << '\n';
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        bool enabled_;
+        const char* current_;
+        Clock::time_point started_;
+        std::vector< std::pair< const char*, std::uint64_t > > phases_;
+
+        void end(Clock::time_point now)
+        {
+            if (current_)
+            {
+                const auto elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                    now - started_).count();
+                phases_.emplace_back(current_, static_cast< std::uint64_t >(elapsed));
+                current_ = nullptr;
+            }
+        }
+    };
+}
+
+#endif
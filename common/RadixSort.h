@@ -0,0 +1,104 @@
+#ifndef COMMON_RADIX_SORT_H
+#define COMMON_RADIX_SORT_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace common
+{
+    // Composite unsigned key of a record, most significant word first, and the
+    // position of the record in its collection.
+    template < std::size_t Words >
+    struct RadixItem
+    {
+        std::uint64_t key[Words];
+        std::uint32_t index;
+    };
+
+    // Unsigned integer with the same order as the double: -0.0 and 0.0 map to
+    // the same value, negative numbers below positive ones.
+    inline std::uint64_t orderedBits(double value)
+    {
+        if (value == 0.0)
+        {
+            value = 0.0;
+        }
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const std::uint64_t sign = std::uint64_t(1) << 63;
+        return (bits & sign) ? ~bits : bits | sign;
+    }
+
+    namespace detail
+    {
+        // 11-bit digits: six passes per word at most, while the 2048 counters
+        // of a pass still fit in the L1 cache.
+        const std::size_t RADIX_BITS = 11;
+        const std::size_t RADIX = 1 << RADIX_BITS;
+        const std::size_t DIGITS_PER_WORD = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+        // Digit 0 holds the least significant bits of the last word.
+        template < std::size_t Words >
+        std::size_t radixDigit(const RadixItem< Words >& item, std::size_t digit)
+        {
+            const std::uint64_t word = item.key[Words - 1 - digit / DIGITS_PER_WORD];
+            return (word >> (digit % DIGITS_PER_WORD * RADIX_BITS)) & (RADIX - 1);
+        }
+    }
+
+    // Stable LSD radix sort by key, one digit per pass. All histograms are
+    // counted in a single sweep, and a pass whose digit is the same in every
+    // item is skipped, so the unused high bits of a key cost nothing. Indices
+    // and counters are 32-bit: more items than that throw std::length_error,
+    // since their indices have wrapped.
+    template < std::size_t Words >
+    void radixSort(std::vector< RadixItem< Words > >& items)
+    {
+        using detail::RADIX;
+        const std::size_t digits = Words * detail::DIGITS_PER_WORD;
+        const std::size_t size = items.size();
+        if (size > std::numeric_limits< std::uint32_t >::max())
+        {
+            throw std::length_error("too many records for 32-bit indices");
+        }
+        if (size < 2)
+        {
+            return;
+        }
+        std::vector< std::uint32_t > counts(digits * RADIX, 0);
+        for (const auto& item : items)
+        {
+            for (std::size_t digit = 0; digit < digits; ++digit)
+            {
+                ++counts[digit * RADIX + detail::radixDigit(item, digit)];
+            }
+        }
+
+        std::vector< RadixItem< Words > > buffer(size);
+        for (std::size_t digit = 0; digit < digits; ++digit)
+        {
+            std::uint32_t* offsets = &counts[digit * RADIX];
+            if (offsets[detail::radixDigit(items.front(), digit)] == size)
+            {
+                continue;
+            }
+            std::uint32_t total = 0;
+            for (std::size_t bucket = 0; bucket < RADIX; ++bucket)
+            {
+                std::uint32_t count = offsets[bucket];
+                offsets[bucket] = total;
+                total += count;
+            }
+            for (const auto& item : items)
+            {
+                buffer[offsets[detail::radixDigit(item, digit)]++] = item;
+            }
+            items.swap(buffer);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,393 @@
+#ifndef COMMON_RECORD_SCHEMA_H
+#define COMMON_RECORD_SCHEMA_H
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "NumberCodec.h"
+#include "TextCursor.h"
+
+// Records of the form (:label value:label value ... :) described once by a
+// schema, from which the parser, the printer and the sort key are generated:
+//
+//     constexpr auto SCHEMA = common::makeSchema(
+//         common::field(":key1", &Data::key1, common::DoubleLiteral< common::Chars< 'd' > >()),
+//         common::field(":key2", &Data::key2, common::RationalLiteral()),
+//         common::field(":key3", &Data::key3, common::QuotedString(), common::ByLength()));
+//
+// A format reads and writes the text of one value, an order projects the
+// value to what the records are sorted by. Everything is resolved at compile
+// time, so the generated code is the same as a hand-written reader.
+namespace common
+{
+    namespace detail
+    {
+        using Expand = int[];
+
+        constexpr std::size_t length(const char* text)
+        {
+            std::size_t size = 0;
+            while (text[size] != '\0')
+            {
+                ++size;
+            }
+            return size;
+        }
+
+        constexpr bool isLetter(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        constexpr char toLower(char c)
+        {
+            return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+        }
+
+        // Unformatted output straight into the stream buffer, for printers
+        // that already hold a sentry.
+        inline void put(std::ostream& out, const char* text, std::size_t size)
+        {
+            std::streamsize count = static_cast< std::streamsize >(size);
+            if (out.rdbuf()->sputn(text, count) != count)
+            {
+                out.setstate(std::ios::badbit);
+            }
+        }
+
+        inline void putFixed(std::ostream& out, double value)
+        {
+            char buffer[FIXED_BUFFER_SIZE];
+            put(out, buffer, formatFixed(buffer, value, 1) - buffer);
+        }
+
+        template < typename T >
+        void putInteger(std::ostream& out, T value, unsigned base = 10)
+        {
+            char buffer[INTEGER_BUFFER_SIZE];
+            put(out, buffer, formatInteger(buffer, value, base) - buffer);
+        }
+    }
+
+    // Fixed characters around a value. Each one is a delimiter of its own;
+    // letters match in either case, as the suffixes of C++ literals do.
+    template < char... C >
+    struct Chars
+    {
+        static bool read(TextCursor& cursor)
+        {
+            bool ok = true;
+            (void)detail::Expand{ 0,
+                (ok = ok && cursor.delimiter(detail::toLower(C), detail::isLetter(C)), 0)... };
+            return ok;
+        }
+
+        static void write(std::ostream& out)
+        {
+            const char text[] = { C..., '\0' };
+            detail::put(out, text, sizeof...(C));
+        }
+    };
+
+    // Formats. Numbers are printed the way printf prints them, doubles with
+    // one decimal. They are written while the schema holds a sentry.
+
+    // 1.5d
+    template < typename Suffix = Chars<> >
+    struct DoubleLiteral
+    {
+        static bool read(TextCursor& cursor, double& dest)
+        {
+            return cursor.floating(dest)
+                && (Suffix::read(cursor) || cursor.fail(ParseError::BAD_SUFFIX));
+        }
+
+        static void write(std::ostream& out, double src)
+        {
+            detail::putFixed(out, src);
+            Suffix::write(out);
+        }
+    };
+
+    // 10ull, 0x1F, 017
+    template < unsigned Base = 10, typename Prefix = Chars<>, typename Suffix = Chars<> >
+    struct IntegerLiteral
+    {
+        template < typename T >
+        static bool read(TextCursor& cursor, T& dest)
+        {
+            return Prefix::read(cursor) && cursor.integer(dest, Base)
+                && (Suffix::read(cursor) || cursor.fail(ParseError::BAD_SUFFIX));
+        }
+
+        template < typename T >
+        static void write(std::ostream& out, T src)
+        {
+            Prefix::write(out);
+            detail::putInteger(out, src, Base);
+            Suffix::write(out);
+        }
+    };
+
+    // (:N -1:D 2:)
+    struct RationalLiteral
+    {
+        template < typename Numerator, typename Denominator >
+        static bool read(TextCursor& cursor, std::pair< Numerator, Denominator >& dest)
+        {
+            return cursor.delimiter('(') && cursor.delimiter(':') && cursor.delimiter('N')
+                && cursor.integer(dest.first) && cursor.delimiter(':') && cursor.delimiter('D')
+                && cursor.integer(dest.second) && cursor.delimiter(':') && cursor.delimiter(')');
+        }
+
+        template < typename Numerator, typename Denominator >
+        static void write(std::ostream& out, const std::pair< Numerator, Denominator >& src)
+        {
+            detail::put(out, "(:N ", 4);
+            detail::putInteger(out, src.first);
+            detail::put(out, ":D ", 3);
+            detail::putInteger(out, src.second);
+            detail::put(out, ":)", 2);
+        }
+    };
+
+    // #c(1.0 -2.0)
+    struct ComplexLiteral
+    {
+        static bool read(TextCursor& cursor, std::complex< double >& dest)
+        {
+            double real = 0;
+            double imag = 0;
+            if (!cursor.delimiter('#') || !cursor.delimiter('c') || !cursor.delimiter('(')
+                || !cursor.floating(real) || !cursor.floating(imag) || !cursor.delimiter(')'))
+            {
+                return false;
+            }
+            dest = std::complex< double >(real, imag);
+            return true;
+        }
+
+        static void write(std::ostream& out, const std::complex< double >& src)
+        {
+            detail::put(out, "#c(", 3);
+            detail::putFixed(out, src.real());
+            detail::put(out, " ", 1);
+            detail::putFixed(out, src.imag());
+            detail::put(out, ")", 1);
+        }
+    };
+
+    // Stores quoted text in a string. A string type of a lab gets its own
+    // overload next to it, found by argument-dependent lookup.
+    inline void assignText(std::string& dest, const char* begin, const char* end)
+    {
+        dest.assign(begin, end);
+    }
+
+    // "text", without escapes
+    struct QuotedString
+    {
+        template < typename String >
+        static bool read(TextCursor& cursor, String& dest)
+        {
+            const char* begin = nullptr;
+            const char* end = nullptr;
+            if (!cursor.quoted(begin, end))
+            {
+                return false;
+            }
+            assignText(dest, begin, end);
+            return true;
+        }
+
+        template < typename String >
+        static void write(std::ostream& out, const String& src)
+        {
+            detail::put(out, "\"", 1);
+            out << src;
+            detail::put(out, "\"", 1);
+        }
+    };
+
+    // Orders. The key of ByValue refers to the field itself.
+
+    struct ByValue
+    {
+        template < typename T >
+        const T& operator()(const T& value) const
+        {
+            return value;
+        }
+    };
+
+    struct ByLength
+    {
+        template < typename T >
+        std::size_t operator()(const T& value) const
+        {
+            return value.size();
+        }
+    };
+
+    struct ByMagnitude
+    {
+        template < typename T >
+        auto operator()(const T& value) const
+        {
+            return std::abs(value);
+        }
+    };
+
+    template < typename Record, typename Value, typename Format, typename Order >
+    struct Field
+    {
+        const char* label;
+        std::size_t length;
+        Value Record::* member;
+
+        bool matches(const char* begin, std::size_t size) const
+        {
+            return size == length && std::memcmp(begin, label, length) == 0;
+        }
+
+        bool read(TextCursor& cursor, Record& dest) const
+        {
+            return Format::read(cursor, dest.*member);
+        }
+
+        void write(std::ostream& out, const Record& src) const
+        {
+            detail::put(out, label, length);
+            detail::put(out, " ", 1);
+            Format::write(out, src.*member);
+        }
+
+        decltype(auto) key(const Record& src) const
+        {
+            return Order()(src.*member);
+        }
+    };
+
+    // The field of Record under label, written in format and sorted by order.
+    template < typename Record, typename Value, typename Format, typename Order = ByValue >
+    constexpr Field< Record, Value, Format, Order > field(const char* label,
+        Value Record::* member, Format, Order = Order())
+    {
+        return { label, detail::length(label), member };
+    }
+
+    template < typename... Fields >
+    class Schema
+    {
+    public:
+        constexpr explicit Schema(Fields... fields) :
+            fields_(fields...)
+        {
+        }
+
+        // A record opens with "(", has every field once or more, the last
+        // occurrence counting, in any order, and closes with ":)". Labels end
+        // at whitespace. dest is left alone unless the whole record is read;
+        // the cursor stops where the first mismatch was found, with the reason
+        // in its error().
+        template < typename Record >
+        bool read(TextCursor& cursor, Record& dest) const
+        {
+            if (!cursor.delimiter('('))
+            {
+                return false;
+            }
+            Record input{};
+            bool seen[sizeof...(Fields)] = {};
+            std::size_t count = 0;
+            while (count < sizeof...(Fields))
+            {
+                const char* begin = nullptr;
+                const char* end = nullptr;
+                if (!cursor.token(begin, end))
+                {
+                    return false;
+                }
+                std::size_t index = sizeof...(Fields);
+                if (!readField(cursor, begin, end - begin, input, index, Indices()))
+                {
+                    return index == sizeof...(Fields) && cursor.fail(ParseError::BAD_LABEL);
+                }
+                count += seen[index] ? 0 : 1;
+                seen[index] = true;
+            }
+            if (!cursor.delimiter(':') || !cursor.delimiter(')'))
+            {
+                return false;
+            }
+            dest = std::move(input);
+            return true;
+        }
+
+        // The fields in the order of the schema, as operator<< would.
+        template < typename Record >
+        void write(std::ostream& out, const Record& src) const
+        {
+            std::ostream::sentry sentry(out);
+            if (!sentry)
+            {
+                return;
+            }
+            detail::put(out, "(", 1);
+            writeFields(out, src, Indices());
+            detail::put(out, ":)", 2);
+        }
+
+        // The keys of the fields in the order of the schema, to be compared
+        // as a tuple.
+        template < typename Record >
+        auto sortKey(const Record& src) const
+        {
+            return sortKey(src, Indices());
+        }
+
+    private:
+        using Indices = std::index_sequence_for< Fields... >;
+
+        std::tuple< Fields... > fields_;
+
+        template < typename Record, std::size_t... I >
+        bool readField(TextCursor& cursor, const char* label, std::size_t length, Record& dest,
+            std::size_t& index, std::index_sequence< I... >) const
+        {
+            bool ok = false;
+            (void)detail::Expand{ 0,
+                (index == sizeof...(Fields) && std::get< I >(fields_).matches(label, length)
+                    ? (index = I, ok = std::get< I >(fields_).read(cursor, dest), 0)
+                    : 0)... };
+            return ok;
+        }
+
+        template < typename Record, std::size_t... I >
+        void writeFields(std::ostream& out, const Record& src, std::index_sequence< I... >) const
+        {
+            (void)detail::Expand{ 0, (std::get< I >(fields_).write(out, src), 0)... };
+        }
+
+        template < typename Record, std::size_t... I >
+        auto sortKey(const Record& src, std::index_sequence< I... >) const
+        {
+            return std::tuple< decltype(std::get< I >(fields_).key(src))... >(
+                std::get< I >(fields_).key(src)...);
+        }
+    };
+
+    template < typename... Fields >
+    constexpr Schema< Fields... > makeSchema(Fields... fields)
+    {
+        return Schema< Fields... >(fields...);
+    }
+}
+
+#endif
@@ -0,0 +1,223 @@
+#ifndef COMMON_TEXT_CURSOR_H
+#define COMMON_TEXT_CURSOR_H
+
+#include <cstddef>
+#include <cstring>
+
+#include "NumberCodec.h"
+
+namespace common
+{
+    // Whitespace as classified by the "C" locale.
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // Why a read failed.
+    enum class ParseError
+    {
+        NONE,
+        // The input ended inside the record.
+        END_OF_INPUT,
+        BAD_DELIMITER,
+        // A field label the schema does not have.
+        BAD_LABEL,
+        BAD_NUMBER,
+        // A number too large for its type.
+        OUT_OF_RANGE,
+        // The characters after a literal, such as the d of 1.5d.
+        BAD_SUFFIX
+    };
+
+    const std::size_t PARSE_ERRORS = 7;
+
+    inline const char* parseErrorName(ParseError error)
+    {
+        static const char* const NAMES[PARSE_ERRORS] = { "none", "end_of_input",
+            "bad_delimiter", "bad_label", "bad_number", "out_of_range", "bad_suffix" };
+        return NAMES[static_cast< std::size_t >(error)];
+    }
+
+    // Reads a contiguous buffer the way formatted input reads a stream in the
+    // "C" locale: every read skips whitespace first, and once a read reaches
+    // the end of the buffer the cursor is at eof and every further read fails.
+    // A failed read leaves the reason in error(); only failures write it, so
+    // reads that succeed pay nothing for it.
+    class TextCursor
+    {
+    public:
+        TextCursor(const char* begin, const char* end) :
+            pos_(begin),
+            end_(end),
+            eof_(false),
+            error_(ParseError::NONE)
+        {
+        }
+
+        const char* position() const
+        {
+            return pos_;
+        }
+
+        // Mirrors eofbit.
+        bool eof() const
+        {
+            return eof_;
+        }
+
+        // Why the last failed read failed.
+        ParseError error() const
+        {
+            return error_;
+        }
+
+        // Records the failure of a read made of several; returns false. At
+        // eof the reason is always the end of the input.
+        bool fail(ParseError error)
+        {
+            error_ = eof_ ? ParseError::END_OF_INPUT : error;
+            return false;
+        }
+
+        bool skipSpace()
+        {
+            if (eof_)
+            {
+                return fail(ParseError::END_OF_INPUT);
+            }
+            while (pos_ != end_ && isSpace(*pos_))
+            {
+                ++pos_;
+            }
+            eof_ = pos_ == end_;
+            return !eof_ || fail(ParseError::END_OF_INPUT);
+        }
+
+        // Takes one character, which has to be exp; with ignoreCase exp has
+        // to be in lower case.
+        bool delimiter(char exp, bool ignoreCase = false)
+        {
+            if (!skipSpace())
+            {
+                return false;
+            }
+            char c = *pos_++;
+            if (ignoreCase && c >= 'A' && c <= 'Z')
+            {
+                c = c - 'A' + 'a';
+            }
+            return c == exp || fail(ParseError::BAD_DELIMITER);
+        }
+
+        // The characters up to the next whitespace, like in >> std::string.
+        bool token(const char*& begin, const char*& end)
+        {
+            if (!skipSpace())
+            {
+                return false;
+            }
+            begin = pos_;
+            while (pos_ != end_ && !isSpace(*pos_))
+            {
+                ++pos_;
+            }
+            end = pos_;
+            eof_ = pos_ == end_;
+            return true;
+        }
+
+        template < typename T >
+        bool integer(T& dest, unsigned base = 10)
+        {
+            if (!skipSpace())
+            {
+                return false;
+            }
+            const char* begin = pos_;
+            ParseResult result = parseInteger(pos_, end_, dest, base);
+            pos_ = result.ptr;
+            eof_ = pos_ == end_;
+            if (result.ok)
+            {
+                return true;
+            }
+            // Digits were read up to the failure only if it was an overflow.
+            const bool overflow = pos_ != begin
+                && static_cast< unsigned >(detail::digitValue(pos_[-1])) < base;
+            return fail(overflow ? ParseError::OUT_OF_RANGE : ParseError::BAD_NUMBER);
+        }
+
+        // Takes the characters num_get consumes for a double; they have to
+        // form a number in range as a whole.
+        bool floating(double& dest)
+        {
+            if (!skipSpace())
+            {
+                return false;
+            }
+            const char* stop = scanFloat(pos_, end_);
+            double value = 0;
+            ParseResult result = parseDouble(pos_, stop, value);
+            const char* begin = pos_;
+            pos_ = stop;
+            eof_ = pos_ == end_;
+            if (!result.ok || result.ptr != stop)
+            {
+                // parseDouble only rejects a number it has read whole when it
+                // is out of range.
+                const bool overflow = !result.ok && result.ptr != begin && result.ptr == stop;
+                return fail(overflow ? ParseError::OUT_OF_RANGE : ParseError::BAD_NUMBER);
+            }
+            dest = value;
+            return true;
+        }
+
+        // Text between double quotes, without unescaping, like
+        // std::getline(in >> '"', text, '"').
+        bool quoted(const char*& begin, const char*& end)
+        {
+            if (!delimiter('"'))
+            {
+                return false;
+            }
+            const void* quote = std::memchr(pos_, '"', end_ - pos_);
+            if (!quote)
+            {
+                pos_ = end_;
+                eof_ = true;
+                return fail(ParseError::END_OF_INPUT);
+            }
+            begin = pos_;
+            end = static_cast< const char* >(quote);
+            pos_ = end + 1;
+            return true;
+        }
+
+        // Moves to the next c, or to the end of the buffer and eof.
+        void skipTo(char c)
+        {
+            const void* found = std::memchr(pos_, c, end_ - pos_);
+            pos_ = found ? static_cast< const char* >(found) : end_;
+            eof_ = pos_ == end_;
+        }
+
+        // Moves past the next c, like ignore(count, c) on a stream.
+        void ignore(char c)
+        {
+            skipTo(c);
+            if (!eof_)
+            {
+                ++pos_;
+            }
+        }
+
+    private:
+        const char* pos_;
+        const char* end_;
+        bool eof_;
+        ParseError error_;
+    };
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef COMMON_TOP_SELECTOR_H
+#define COMMON_TOP_SELECTOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace common
+{
+    // The first limit of the values pushed, in the order a stable sort by
+    // comp would put all of them in, with only those limit values in memory.
+    // They are kept in a heap whose top is the last of them; values that are
+    // equivalent by comp are ordered by arrival, so a later value only gets
+    // in if it is strictly before the top. O(n log limit) for n values.
+    template < typename T, typename Compare >
+    class TopSelector
+    {
+    public:
+        TopSelector(std::size_t limit, Compare comp) :
+            limit_(limit),
+            comp_(comp),
+            count_(0)
+        {
+        }
+
+        void push(const T& value)
+        {
+            if (heap_.size() < limit_)
+            {
+                heap_.push_back(Entry{ value, count_++ });
+                std::push_heap(heap_.begin(), heap_.end(), order());
+            }
+            else if (limit_ != 0 && comp_(value, heap_.front().value))
+            {
+                std::pop_heap(heap_.begin(), heap_.end(), order());
+                heap_.back() = Entry{ value, count_++ };
+                std::push_heap(heap_.begin(), heap_.end(), order());
+            }
+            else
+            {
+                ++count_;
+            }
+        }
+
+        // The selected values in order; the selector is empty afterwards.
+        std::vector< T > finish()
+        {
+            std::sort_heap(heap_.begin(), heap_.end(), order());
+            std::vector< T > result;
+            result.reserve(heap_.size());
+            for (Entry& entry : heap_)
+            {
+                result.push_back(std::move(entry.value));
+            }
+            heap_.clear();
+            return result;
+        }
+
+    private:
+        struct Entry
+        {
+            T value;
+            std::uint64_t sequence;
+        };
+
+        std::size_t limit_;
+        Compare comp_;
+        std::uint64_t count_;
+        std::vector< Entry > heap_;
+
+        auto order() const
+        {
+            const Compare& comp = comp_;
+            return [&comp](const Entry& left, const Entry& right)
+            {
+                if (comp(left.value, right.value))
+                {
+                    return true;
+                }
+                return !comp(right.value, left.value) && left.sequence < right.sequence;
+            };
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef COMMON_TRACE_H
+#define COMMON_TRACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace common
+{
+    // Opt-in recorder of scoped events, written as Chrome trace-event JSON.
+    // Every thread records into its own fixed-size ring buffer, which only that
+    // thread writes, so recording takes no lock; a full ring drops its oldest
+    // events.
+    class Tracer
+    {
+    public:
+        static const std::size_t RING_CAPACITY = 1 << 15;
+        static const std::size_t NAME_SIZE = 24;
+        static const std::size_t ARGS_SIZE = 72;
+
+        static Tracer& instance()
+        {
+            static Tracer tracer;
+            return tracer;
+        }
+
+        bool enabled() const
+        {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        void enable(const std::string& path)
+        {
+            path_ = path;
+            origin_ = std::chrono::steady_clock::now();
+            enabled_.store(true, std::memory_order_relaxed);
+        }
+
+        std::uint64_t now() const
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - origin_;
+            return std::chrono::duration_cast< std::chrono::nanoseconds >(elapsed).count();
+        }
+
+        void record(const char* name, const std::string& args, std::uint64_t start)
+        {
+            const std::uint64_t end = now();
+            Ring& ring = threadRing();
+            const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+            Event& event = ring.events[head % RING_CAPACITY];
+            copyTruncated(event.name, NAME_SIZE, name, std::char_traits< char >::length(name));
+            copyTruncated(event.args, ARGS_SIZE, args.data(), args.size());
+            event.start = start;
+            event.duration = end - start;
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+
+        // Expected to run once recording threads are finished, e.g. at exit.
+        bool dump()
+        {
+            std::ofstream out(path_);
+            if (!out)
+            {
+                return false;
+            }
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool first = true;
+            std::lock_guard< std::mutex > lock(ringsMutex_);
+            for (const auto& ring : rings_)
+            {
+                const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+                const std::uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+                for (std::uint64_t i = begin; i < head; ++i)
+                {
+                    const Event& event = ring->events[i % RING_CAPACITY];
+                    out << (first ? "\n" : ",\n") << "{\"name\":\"";
+                    writeEscaped(out, event.name);
+                    out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->tid
+                        << ",\"ts\":" << event.start / 1000 << '.' << event.start % 1000 / 100
+                        << ",\"dur\":" << event.duration / 1000 << '.'
+                        << event.duration % 1000 / 100 << ",\"args\":{\"detail\":\"";
+                    writeEscaped(out, event.args);
+                    out << "\"}}";
+                    first = false;
+                }
+            }
+            out << "\n]}\n";
+            return static_cast< bool >(out);
+        }
+
+    private:
+        struct Event
+        {
+            char name[NAME_SIZE];
+            char args[ARGS_SIZE];
+            std::uint64_t start;
+            std::uint64_t duration;
+        };
+
+        struct Ring
+        {
+            explicit Ring(std::uint32_t id) :
+                tid(id),
+                head(0),
+                events(RING_CAPACITY)
+            {
+            }
+
+            std::uint32_t tid;
+            std::atomic< std::uint64_t > head;
+            std::vector< Event > events;
+        };
+
+        std::atomic< bool > enabled_;
+        std::string path_;
+        std::chrono::steady_clock::time_point origin_;
+        std::mutex ringsMutex_;
+        std::vector< std::unique_ptr< Ring > > rings_;
+
+        Tracer() :
+            enabled_(false)
+        {
+        }
+
+        Ring& threadRing()
+        {
+            thread_local Ring* ring = nullptr;
+            if (!ring)
+            {
+                std::lock_guard< std::mutex > lock(ringsMutex_);
+                rings_.emplace_back(new Ring(static_cast< std::uint32_t >(rings_.size() + 1)));
+                ring = rings_.back().get();
+            }
+            return *ring;
+        }
+
+        static void copyTruncated(char* dest, std::size_t size, const char* src,
+            std::size_t length)
+        {
+            const std::size_t n = length < size - 1 ? length : size - 1;
+            std::copy(src, src + n, dest);
+            dest[n] = '\0';
+        }
+
+        static void writeEscaped(std::ostream& out, const char* text)
+        {
+            for (; *text; ++text)
+            {
+                const unsigned char c = static_cast< unsigned char >(*text);
+                if (c == '"' || c == '\\')
+                {
+                    out << '\\' << *text;
+                }
+                else if (c < 0x20)
+                {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    out << code;
+                }
+                else
+                {
+                    out << *text;
+                }
+            }
+        }
+    };
+
+    // Records the lifetime of the scope as one complete ("X") event.
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name, const std::string& args = "") :
+            name_(Tracer::instance().enabled() ? name : nullptr),
+            args_(name_ ? args : std::string()),
+            start_(name_ ? Tracer::instance().now() : 0)
+        {
+        }
+
+        ~TraceScope()
+        {
+            if (name_)
+            {
+                Tracer::instance().record(name_, args_, start_);
+            }
+        }
+
+    private:
+        const char* name_;
+        std::string args_;
+        std::uint64_t start_;
+    };
+}
+
+#endif
@@ -1,28 +1,21 @@
 ﻿#include <algorithm>
-#include <iomanip>
+#include <cctype>
 #include <iostream>
 #include <iterator>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <limits>
 
+#include "NumberCodec.h"
+#include "PhaseStats.h"
+#include "RadixSort.h"
+
 struct DataStruct {
     unsigned long long key1_;
     unsigned long long key2_;
     std::string key3_;
 };
 
-class IofmtGuard {
-public:
-    IofmtGuard(std::basic_ios<char>& stream) : stream_(stream), flags_(stream.flags()) {}
-    ~IofmtGuard() { stream_.flags(flags_); }
-
-private:
-    std::basic_ios<char>& stream_;
-    std::ios_base::fmtflags flags_;
-};
-
 std::istream& operator>>(std::istream& input, DataStruct& data) {
     std::istream::sentry sentry(input);
     if (!sentry) {
@@ -65,9 +58,14 @@ std::istream& operator>>(std::istream& input, DataStruct& data) {
                 break;
             }
 
-            std::istringstream iss(valueStr.substr(0, valueStr.size() - 3));
+            const char* first = valueStr.data();
+            const char* last = first + valueStr.size() - 3;
+            while (first != last && std::isspace(static_cast<unsigned char>(*first))) {
+                ++first;
+            }
             unsigned long long value;
-            if (!(iss >> value) || iss.rdbuf()->in_avail() > 0) {
+            common::ParseResult parsed = common::parseInteger(first, last, value);
+            if (!parsed.ok || parsed.ptr != last) {
                 valid = false;
                 break;
             }
@@ -85,7 +83,7 @@ std::istream& operator>>(std::istream& input, DataStruct& data) {
             }
 
             unsigned long long value;
-            if (!(input >> std::hex >> value)) {
+            if (!common::readInteger(input, value, 16)) {
                 valid = false;
                 break;
             }
@@ -130,9 +128,11 @@ std::ostream& operator<<(std::ostream& output, const DataStruct& data) {
         return output;
     }
 
-    IofmtGuard guard(output);
-    output << "(:key1 " << data.key1_ << "ull:key2 0x" << std::hex << std::uppercase
-        << data.key2_ << std::dec << ":key3 \"" << data.key3_ << "\":)";
+    output << "(:key1 ";
+    common::writeInteger(output, data.key1_);
+    output << "ull:key2 0x";
+    common::writeInteger(output, data.key2_, 16);
+    output << ":key3 \"" << data.key3_ << "\":)";
     return output;
 }
 
@@ -148,7 +148,10 @@ bool compareData(const DataStruct& first, const DataStruct& second) {
     return first.key3_.length() < second.key3_.length();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+    common::PhaseStats stats(argc, argv);
+    stats.start("parse");
     std::vector<DataStruct> ds;
     while (!std::cin.eof()) {
         std::copy(
@@ -162,11 +165,19 @@ int main() {
         std::cin.clear();
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     }
-    std::sort(ds.begin(), ds.end(), compareData);
-    std::copy(
-        ds.begin(),
-        ds.end(),
-        std::ostream_iterator<DataStruct>(std::cout, "\n")
-    );
+    stats.start("sort");
+    // Same order as compareData: key1, key2, then the length of key3.
+    std::vector<common::RadixItem<3>> order(ds.size());
+    for (std::size_t i = 0; i < ds.size(); ++i) {
+        order[i] = { { ds[i].key1_, ds[i].key2_, ds[i].key3_.size() },
+            static_cast<std::uint32_t>(i) };
+    }
+    common::radixSort(order);
+    stats.start("print");
+    for (const auto& item : order) {
+        std::cout << ds[item.index] << "\n";
+    }
+    std::cout.flush();
+    stats.finish();
     return 0;
 }
@@ -1,26 +1,88 @@
 #include "DataStruct.h"
 
+#include <cmath>
+
+#include "IndexSort.h"
+#include "NumberCodec.h"
+#include "RadixSort.h"
+
 namespace dataStruct
 {
-    bool compareData(const DataStruct& left, const DataStruct& right)
+    namespace
     {
-        const double leftAbs = std::abs(left.key1);
-        const double rightAbs = std::abs(right.key1);
+        const double EPSILON = 1e-10;
 
-        if (std::abs(leftAbs - rightAbs) > 1e-10)
+        // Whether compareKeys sees a tie where the exact order does not, for
+        // keys next to each other in the exact order.
+        bool isNearTie(const SortKey& left, const SortKey& right)
         {
-            return leftAbs < rightAbs;
+            if (left.magnitude != right.magnitude)
+            {
+                return right.magnitude - left.magnitude <= EPSILON;
+            }
+            return left.ratio != right.ratio && right.ratio - left.ratio <= EPSILON;
         }
+    }
 
-        const double leftRatio = static_cast<double>(left.key2.first) / left.key2.second;
-        const double rightRatio = static_cast<double>(right.key2.first) / right.key2.second;
+    SortKey makeSortKey(const DataStruct& data)
+    {
+        const double ratio = static_cast<double>(data.key2.first) / data.key2.second;
+        return { std::abs(data.key1), ratio, data.key3.length() };
+    }
 
-        if (std::abs(leftRatio - rightRatio) > 1e-10)
+    bool compareKeys(const SortKey& left, const SortKey& right)
+    {
+        if (std::abs(left.magnitude - right.magnitude) > EPSILON)
         {
-            return leftRatio < rightRatio;
+            return left.magnitude < right.magnitude;
         }
 
-        return left.key3.length() < right.key3.length();
+        if (std::abs(left.ratio - right.ratio) > EPSILON)
+        {
+            return left.ratio < right.ratio;
+        }
+
+        return left.length < right.length;
+    }
+
+    bool compareData(const DataStruct& left, const DataStruct& right)
+    {
+        return compareKeys(makeSortKey(left), makeSortKey(right));
+    }
+
+    std::vector<std::uint32_t> sortedOrder(const std::vector<DataStruct>& data)
+    {
+        std::vector<SortKey> keys;
+        keys.reserve(data.size());
+        std::vector<common::RadixItem<3>> items(data.size());
+        bool exact = true;
+        for (std::size_t i = 0; i < data.size(); ++i)
+        {
+            keys.push_back(makeSortKey(data[i]));
+            const SortKey& key = keys.back();
+            // A NaN ratio ties with every ratio.
+            exact = exact && !std::isnan(key.ratio);
+            items[i] = { { common::orderedBits(key.magnitude), common::orderedBits(key.ratio),
+                key.length }, static_cast<std::uint32_t>(i) };
+        }
+        if (exact)
+        {
+            common::radixSort(items);
+            for (std::size_t i = 1; exact && i < items.size(); ++i)
+            {
+                exact = !isNearTie(keys[items[i - 1].index], keys[items[i].index]);
+            }
+        }
+        if (!exact)
+        {
+            return common::sortedIndices(data, makeSortKey, compareKeys);
+        }
+        std::vector<std::uint32_t> order(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            order[i] = items[i].index;
+        }
+        return order;
     }
 
     std::istream& operator>>(std::istream& in, DelimiterIO&& dest)
@@ -51,8 +113,10 @@ namespace dataStruct
 
         double real = 0.0;
         double imag = 0.0;
-        in >> DelimiterIO{'#'} >> DelimiterIO{'c'} >> DelimiterIO{'('}
-           >> real >> imag >> DelimiterIO{')'};
+        in >> DelimiterIO{'#'} >> DelimiterIO{'c'} >> DelimiterIO{'('};
+        common::readDouble(in, real);
+        common::readDouble(in, imag);
+        in >> DelimiterIO{')'};
 
         if (in)
         {
@@ -79,7 +143,7 @@ namespace dataStruct
             return in;
         }
 
-        in >> dest.ref;
+        common::readInteger(in, dest.ref);
         if (in.peek() == 'l' || in.peek() == 'L')
         {
             in.ignore(2);
@@ -94,7 +158,7 @@ namespace dataStruct
         {
             return in;
         }
-        return in >> dest.ref;
+        return common::readInteger(in, dest.ref);
     }
 
     std::istream& operator>>(std::istream& in, DataStruct& dest)
@@ -168,28 +232,15 @@ namespace dataStruct
             return out;
         }
 
-        IOFormatGuard guard(out);
-
-        out << "(:key1 #c(" << std::fixed << std::setprecision(1)
-            << src.key1.real() << " " << src.key1.imag() << ")"
-            << ":key2 (:N " << src.key2.first << ":D " << src.key2.second << ":)"
-            << ":key3 \"" << src.key3 << "\":)";
+        out << "(:key1 #c(";
+        common::writeFixed(out, src.key1.real(), 1);
+        out << " ";
+        common::writeFixed(out, src.key1.imag(), 1);
+        out << "):key2 (:N ";
+        common::writeInteger(out, src.key2.first);
+        out << ":D ";
+        common::writeInteger(out, src.key2.second);
+        out << ":):key3 \"" << src.key3 << "\":)";
         return out;
     }
-
-    IOFormatGuard::IOFormatGuard(std::basic_ios<char>& s) :
-        s_(s),
-        width_(s.width(0)),
-        fill_(s.fill(' ')),
-        precision_(s.precision(6)),
-        fmt_(s.flags())
-    {}
-
-    IOFormatGuard::~IOFormatGuard()
-    {
-        s_.width(width_);
-        s_.fill(fill_);
-        s_.precision(precision_);
-        s_.flags(fmt_);
-    }
 }
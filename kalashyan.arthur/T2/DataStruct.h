@@ -5,6 +5,8 @@
 #include <complex>
 #include <string>
 #include <iomanip>
+#include <cstdint>
+#include <vector>
 
 namespace dataStruct
 {
@@ -15,8 +17,25 @@ namespace dataStruct
         std::string key3;
     };
 
+    // What compareData looks at in a record, computed once per record.
+    struct SortKey
+    {
+        double magnitude;
+        double ratio;
+        std::size_t length;
+    };
+
+    SortKey makeSortKey(const DataStruct& data);
+    bool compareKeys(const SortKey& left, const SortKey& right);
     bool compareData(const DataStruct& left, const DataStruct& right);
 
+    // Positions of data in the order of a stable sort by compareData. The
+    // keys are radix sorted as integers, which gives that order unless two
+    // different magnitudes, or two different ratios under one magnitude, are
+    // within compareKeys' epsilon of each other; then compareKeys sorts them.
+    // Positions are 32-bit, as radixSort takes at most 2^32 records.
+    std::vector<std::uint32_t> sortedOrder(const std::vector<DataStruct>& data);
+
     struct DelimiterIO
     {
         char exp;
@@ -42,19 +61,6 @@ namespace dataStruct
         unsigned long long& ref;
     };
 
-    class IOFormatGuard
-    {
-    public:
-        explicit IOFormatGuard(std::basic_ios<char>& s);
-        ~IOFormatGuard();
-    private:
-        std::basic_ios<char>& s_;
-        std::streamsize width_;
-        char fill_;
-        std::streamsize precision_;
-        std::ios::fmtflags fmt_;
-    };
-
     std::istream& operator>>(std::istream& in, DelimiterIO&& dest);
     std::istream& operator>>(std::istream& in, ComplexIO&& dest);
     std::istream& operator>>(std::istream& in, StringIO&& dest);
@@ -4,8 +4,29 @@
 #include <iterator>
 #include <limits>
 
-int main()
+#include "PhaseStats.h"
+
+
+namespace
 {
+    // Skips the lines whose first character would fail the next read, each
+    // one up to the newline like the retry below, without setting up a
+    // record read per line.
+    void skipToRecord(std::istream& in)
+    {
+        constexpr auto maxIgnore = std::numeric_limits<std::streamsize>::max();
+        while ((in >> std::ws) && !in.eof() && in.peek() != '(')
+        {
+            in.ignore(maxIgnore, '\n');
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::ios::sync_with_stdio(false);
+    common::PhaseStats stats(argc, argv);
+    stats.start("parse");
     using dataStruct::DataStruct;
     std::vector<DataStruct> dataVector;
 
@@ -22,18 +43,19 @@ int main()
             std::cin.clear();
             constexpr auto maxIgnore = std::numeric_limits<std::streamsize>::max();
             std::cin.ignore(maxIgnore, '\n');
+            skipToRecord(std::cin);
         }
     }
 
-    std::sort(
-        dataVector.begin(),
-        dataVector.end(),
-        dataStruct::compareData);
-    std::copy(
-        dataVector.begin(),
-        dataVector.end(),
-        std::ostream_iterator<DataStruct>(std::cout, "\n")
-    );
+    stats.start("sort");
+    const std::vector<std::uint32_t> order = dataStruct::sortedOrder(dataVector);
+    stats.start("print");
+    for (std::uint32_t index : order)
+    {
+        std::cout << dataVector[index] << '\n';
+    }
+    std::cout.flush();
+    stats.finish();
 
     return 0;
 }
@@ -10,38 +10,14 @@
 #include <cctype>
 #include <fstream>
 #include <limits>
+#include <tuple>
+
+#include "IndexSort.h"
+#include "NumberCodec.h"
+#include "PhaseStats.h"
 
 namespace nspace
 {
-    class iofmtguard
-    {
-    public:
-        iofmtguard(std::basic_ios< char >& s);
-        ~iofmtguard();
-    private:
-        std::basic_ios< char >& s_;
-        std::streamsize width_;
-        char fill_;
-        std::streamsize precision_;
-        std::basic_ios< char >::fmtflags fmt_;
-    };
-
-    iofmtguard::iofmtguard(std::basic_ios< char >& s) :
-        s_(s),
-        width_(s.width()),
-        fill_(s.fill()),
-        precision_(s.precision()),
-        fmt_(s.flags())
-    {}
-
-    iofmtguard::~iofmtguard()
-    {
-        s_.width(width_);
-        s_.fill(fill_);
-        s_.precision(precision_);
-        s_.flags(fmt_);
-    }
-
     struct Data
     {
         unsigned long long key1;
@@ -139,7 +115,7 @@ namespace nspace
         {
             return in;
         }
-        return in >> dest.ref >> LabelUll{ "ull" };
+        return common::readInteger(in, dest.ref) >> LabelUll{ "ull" };
     }
     std::istream& operator>>(std::istream& in, ComplexStruct&& dest)
     {
@@ -180,7 +156,8 @@ namespace nspace
         }
         double r = 1.0;
         double im = 1.0;
-        in >> r >> im;
+        common::readDouble(in, r);
+        common::readDouble(in, im);
         x.real(r);
         x.imag(im);
         return in;
@@ -253,43 +230,27 @@ namespace nspace
         {
             return out;
         }
-        iofmtguard fmtguard(out);
-        out << "(";
-        out << ":key1 " << std::fixed << std::setprecision(1) << src.key1 << "ull";
-        out << ":key2 #c("  << src.key2.real() << " " << src.key2.imag() << ")";
-        out << ":key3 \"" << src.key3;
-        out << "\":)";
+        out << "(:key1 ";
+        common::writeInteger(out, src.key1);
+        out << "ull:key2 #c(";
+        common::writeFixed(out, src.key2.real(), 1);
+        out << " ";
+        common::writeFixed(out, src.key2.imag(), 1);
+        out << "):key3 \"" << src.key3 << "\":)";
         return out;
     }
 }
 using nspace::Data;
-bool cmp(const Data& first, const Data& other) { // tmp1 <= tmp2
-    if (first.key1 < other.key1) {
-        return true;
-    }
-    else if (first.key1 > other.key1) {
-        return false;
-    }
-    else {
-        if (std::abs(first.key2) < std::abs(other.key2)) {
-            return true;
-        }
-        else if (std::abs(first.key2) > std::abs(other.key2)) {
-            return false;
-        }
-        else {
-            if (first.key3.size() < other.key3.size()) {
-                return true;
-            }
-            else {
-                return false;
-            }
-        }
-    }
+// key1, then the magnitude of key2, then the length of key3.
+std::tuple< unsigned long long, double, std::size_t > sortKey(const Data& data) {
+    return std::make_tuple(data.key1, std::abs(data.key2), data.key3.size());
 }
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+    common::PhaseStats stats(argc, argv);
+    stats.start("parse");
     using nspace::Data;
     std::vector<Data> data;
     while (!std::cin.eof()) {
@@ -303,11 +264,14 @@ int main() {
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         }
     }
-    std::sort(std::begin(data), std::end(data), cmp);
-    std::copy(
-        std::begin(data),
-        std::end(data),
-        std::ostream_iterator< Data >(std::cout, "\n")
-    );
+    stats.start("sort");
+    const std::vector< std::uint32_t > order = common::sortedIndices(data, sortKey,
+        std::less< decltype(sortKey(data.front())) >());
+    stats.start("print");
+    for (std::uint32_t index : order) {
+        std::cout << data[index] << '\n';
+    }
+    std::cout.flush();
+    stats.finish();
     return 0;
 }
@@ -1,5 +1,7 @@
 #include "DataStruct.h"
 
+#include "NumberCodec.h"
+
 
 namespace nspace
 {
@@ -17,14 +19,14 @@ namespace nspace
     {
         std::istream::sentry sentry(in);
         if (!sentry) return in;
-        return in >> dest.ref >> DelimiterIO{ 'l' } >> DelimiterIO{ 'l' };
+        return common::readInteger(in, dest.ref) >> DelimiterIO{ 'l' } >> DelimiterIO{ 'l' };
     }
 
     std::istream& operator>>(std::istream& in, LongLongIO&& dest)
     {
         std::istream::sentry sentry(in);
         if (!sentry) return in;
-        return in >> dest.ref;
+        return common::readInteger(in, dest.ref);
     }
 
 
@@ -32,7 +34,7 @@ namespace nspace
     {
         std::istream::sentry sentry(in);
         if (!sentry) return in;
-        return in >> dest.ref;
+        return common::readInteger(in, dest.ref);
     }
 
     std::istream& operator>>(std::istream& in, PairIO&& dest)
@@ -102,26 +104,13 @@ namespace nspace
     {
         std::ostream::sentry sentry(out);
         if (!sentry) return out;
-        iofmtguard fmtguard(out);
-        out << "(:key1 " << src.key1 << "ll";
-        out << ":key2 (:N " << src.key2.first << ":D " << src.key2.second << ":)";
-        out << ":key3 \"" << src.key3 << "\":)";
+        out << "(:key1 ";
+        common::writeInteger(out, src.key1);
+        out << "ll:key2 (:N ";
+        common::writeInteger(out, src.key2.first);
+        out << ":D ";
+        common::writeInteger(out, src.key2.second);
+        out << ":):key3 \"" << src.key3 << "\":)";
         return out;
     }
-
-    iofmtguard::iofmtguard(std::basic_ios<char>& s) :
-        s_(s),
-        width_(s.width()),
-        fill_(s.fill()),
-        precision_(s.precision()),
-        fmt_(s.flags())
-    {}
-
-    iofmtguard::~iofmtguard()
-    {
-        s_.width(width_);
-        s_.fill(fill_);
-        s_.precision(precision_);
-        s_.flags(fmt_);
-    }
 }
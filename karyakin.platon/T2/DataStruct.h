@@ -56,19 +56,6 @@ namespace nspace
         std::string exp;
     };
 
-    class iofmtguard
-    {
-    public:
-        iofmtguard(std::basic_ios<char>& s);
-        ~iofmtguard();
-    private:
-        std::basic_ios<char>& s_;
-        std::streamsize width_;
-        char fill_;
-        std::streamsize precision_;
-        std::basic_ios<char>::fmtflags fmt_;
-    };
-
     std::istream& operator>>(std::istream& in, DelimiterIO&& dest);
     std::istream& operator>>(std::istream& in, LongLongIO&& dest);
     std::istream& operator>>(std::istream& in, PairIO&& dest);
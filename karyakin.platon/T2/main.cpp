@@ -1,7 +1,13 @@
 #include "DataStruct.h"
+#include "IndexSort.h"
+#include "PhaseStats.h"
 
-int main()
+#include <tuple>
+
+int main(int argc, char* argv[])
 {
+    common::PhaseStats stats(argc, argv);
+    stats.start("parse");
     using nspace::DataStruct;
 
     std::vector<DataStruct> data;
@@ -24,18 +30,20 @@ int main()
     }
 
 
-    std::sort(data.begin(), data.end(), [](const DataStruct& a, const DataStruct& b) {
-        if (a.key1 != b.key1) return a.key1 < b.key1;
-        if (a.key2 != b.key2) return a.key2 < b.key2;
-        return a.key3.size() < b.key3.size();
-        });
-
-
-    std::copy(
-        data.begin(),
-        data.end(),
-        std::ostream_iterator<DataStruct>(std::cout, "\n")
-    );
+    stats.start("sort");
+    // Same order as key1, then key2, then the length of key3.
+    auto sortKey = [](const DataStruct& a) {
+        return std::make_tuple(a.key1, a.key2, a.key3.size());
+        };
+    const std::vector<std::uint32_t> order = common::sortedIndices(data, sortKey,
+        std::less<decltype(sortKey(data.front()))>());
+    stats.start("print");
+    for (std::uint32_t index : order)
+    {
+        std::cout << data[index] << '\n';
+    }
+    std::cout.flush();
+    stats.finish();
 
     return 0;
 }
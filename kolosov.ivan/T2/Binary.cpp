@@ -0,0 +1,146 @@
+#include "Binary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace dataStruct
+{
+    namespace
+    {
+        const std::size_t HEADER_SIZE = 3 * 8 + 4;
+
+        const char STREAM_MAGIC[] = { 'T', '2', 'R', 'B' };
+        const std::uint16_t STREAM_VERSION = 1;
+        const std::string STREAM_SCHEMA = "kolosov.ivan/T2";
+
+        // key3 is read in pieces of at most this size, so that a corrupt
+        // length fails at the end of the input instead of allocating it.
+        const std::size_t KEY3_CHUNK = 1 << 16;
+
+        void write(std::FILE* file, const void* data, std::size_t size)
+        {
+            if (std::fwrite(data, 1, size, file) != size)
+            {
+                throw std::runtime_error("could not write binary records");
+            }
+        }
+
+        void putBytes(unsigned char* dest, std::uint64_t value, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                dest[i] = static_cast<unsigned char>(value >> (8 * i));
+            }
+        }
+
+        std::uint64_t getBytes(const unsigned char* src, std::size_t count)
+        {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                value |= static_cast<std::uint64_t>(src[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        void writeRecord(std::FILE* file, double key1,
+            const std::pair<long long, unsigned long long>& key2, const char* key3,
+            std::size_t key3Size)
+        {
+            if (key3Size > std::numeric_limits<std::uint32_t>::max())
+            {
+                throw std::length_error("key3 is too long for the binary encoding");
+            }
+            unsigned char header[HEADER_SIZE];
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &key1, sizeof(bits));
+            putBytes(header, bits, 8);
+            putBytes(header + 8, static_cast<std::uint64_t>(key2.first), 8);
+            putBytes(header + 16, key2.second, 8);
+            putBytes(header + 24, key3Size, 4);
+            write(file, header, HEADER_SIZE);
+            write(file, key3, key3Size);
+        }
+    }
+
+    void writeBinary(std::FILE* file, const DataStruct& record)
+    {
+        writeRecord(file, record.key1, record.key2, record.key3.data(), record.key3.size());
+    }
+
+    void writeBinary(std::FILE* file, const RecordView& record)
+    {
+        writeRecord(file, record.key1, record.key2, record.key3.data, record.key3.size);
+    }
+
+    bool readBinary(std::FILE* file, DataStruct& record)
+    {
+        unsigned char header[HEADER_SIZE];
+        std::size_t count = std::fread(header, 1, HEADER_SIZE, file);
+        if (count == 0)
+        {
+            return false;
+        }
+        if (count != HEADER_SIZE)
+        {
+            throw std::runtime_error("truncated binary record");
+        }
+        std::uint64_t key1 = getBytes(header, 8);
+        std::memcpy(&record.key1, &key1, sizeof(key1));
+        record.key2.first = static_cast<long long>(getBytes(header + 8, 8));
+        record.key2.second = getBytes(header + 16, 8);
+        record.key3.clear();
+        for (std::size_t left = getBytes(header + 24, 4); left != 0;)
+        {
+            const std::size_t chunk = std::min(left, KEY3_CHUNK);
+            const std::size_t size = record.key3.size();
+            record.key3.resize(size + chunk);
+            if (std::fread(&record.key3[size], 1, chunk, file) != chunk)
+            {
+                throw std::runtime_error("truncated binary record");
+            }
+            left -= chunk;
+        }
+        return true;
+    }
+
+    void writeBinaryHeader(std::FILE* file)
+    {
+        unsigned char header[sizeof(STREAM_MAGIC) + 4];
+        std::memcpy(header, STREAM_MAGIC, sizeof(STREAM_MAGIC));
+        putBytes(header + sizeof(STREAM_MAGIC), STREAM_VERSION, 2);
+        putBytes(header + sizeof(STREAM_MAGIC) + 2, STREAM_SCHEMA.size(), 2);
+        write(file, header, sizeof(header));
+        write(file, STREAM_SCHEMA.data(), STREAM_SCHEMA.size());
+    }
+
+    void readBinaryHeader(std::FILE* file)
+    {
+        unsigned char header[sizeof(STREAM_MAGIC) + 4];
+        if (std::fread(header, 1, sizeof(header), file) != sizeof(header)
+            || std::memcmp(header, STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0)
+        {
+            throw std::runtime_error("input is not a binary record stream");
+        }
+        std::uint64_t version = getBytes(header + sizeof(STREAM_MAGIC), 2);
+        std::string schema(getBytes(header + sizeof(STREAM_MAGIC) + 2, 2), '\0');
+        if (!schema.empty() && std::fread(&schema[0], 1, schema.size(), file) != schema.size())
+        {
+            throw std::runtime_error("truncated binary stream header");
+        }
+        if (schema != STREAM_SCHEMA)
+        {
+            throw std::runtime_error("binary records of " + schema + ", expected "
+                + STREAM_SCHEMA);
+        }
+        if (version != STREAM_VERSION)
+        {
+            throw std::runtime_error("binary format version " + std::to_string(version)
+                + ", expected " + std::to_string(STREAM_VERSION));
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef BINARY_H
+#define BINARY_H
+
+#include <cstdio>
+
+#include "DataStruct.h"
+#include "RecordView.h"
+
+namespace dataStruct
+{
+    // Little-endian record encoding: key1 as its IEEE 754 bits, the key2
+    // numerator and denominator as 64-bit integers, key3 as a 32-bit length
+    // followed by its bytes. Writing throws std::runtime_error if the file
+    // does not take all of it.
+    void writeBinary(std::FILE* file, const DataStruct& record);
+    void writeBinary(std::FILE* file, const RecordView& record);
+
+    // False at the end of the file; throws std::runtime_error on a
+    // truncated record.
+    bool readBinary(std::FILE* file, DataStruct& record);
+
+    // A stream of binary records between programs starts with a header: the
+    // magic "T2RB", a 16-bit format version, and the name of the record
+    // schema as a 16-bit length and its bytes, so that records of another
+    // variant or version are refused instead of misread.
+    void writeBinaryHeader(std::FILE* file);
+    // Throws std::runtime_error unless the file starts with the header this
+    // program writes.
+    void readBinaryHeader(std::FILE* file);
+
+    // Record encoding and memory estimate for common::ExternalSorter.
+    struct BinaryCodec
+    {
+        static void write(std::FILE* file, const DataStruct& record)
+        {
+            writeBinary(file, record);
+        }
+
+        static bool read(std::FILE* file, DataStruct& record)
+        {
+            return readBinary(file, record);
+        }
+
+        static std::size_t footprint(const DataStruct& record)
+        {
+            return record.key3.capacity();
+        }
+    };
+}
+
+#endif
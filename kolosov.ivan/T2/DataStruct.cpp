@@ -1,5 +1,8 @@
 #include "DataStruct.h"
 
+#include "NumberCodec.h"
+#include "Schema.h"
+
 static const int NEXT_CHAR_AS_LOWERCASE_DATA_ID = std::ios::xalloc();
 
 namespace dataStruct
@@ -67,7 +70,8 @@ namespace dataStruct
         {
             return in;
         }
-        return in >> dest.ref >> nextCharAsLowercase >> DelimiterIO{ 'd' };
+        common::readDouble(in, dest.ref);
+        return in >> nextCharAsLowercase >> DelimiterIO{ 'd' };
     }
 
     std::istream& operator>>(std::istream& in, StringIO&& dest)
@@ -87,8 +91,9 @@ namespace dataStruct
         {
             return in;
         }
-        return in >> DelimiterIO{ '(' } >> DelimiterIO{ ':' } >> DelimiterIO{ 'N' }\
-            >> dest.ref >> DelimiterIO{ ':' };
+        in >> DelimiterIO{ '(' } >> DelimiterIO{ ':' } >> DelimiterIO{ 'N' };
+        common::readInteger(in, dest.ref);
+        return in >> DelimiterIO{ ':' };
     }
 
     std::istream& operator>>(std::istream& in, UnsignedLongLongIO&& dest)
@@ -98,8 +103,9 @@ namespace dataStruct
         {
             return in;
         }
-        return in >> DelimiterIO{ 'D' } >> dest.ref \
-            >> DelimiterIO{ ':' } >> DelimiterIO{ ')' };
+        in >> DelimiterIO{ 'D' };
+        common::readInteger(in, dest.ref);
+        return in >> DelimiterIO{ ':' } >> DelimiterIO{ ')' };
     }
 
     std::istream& operator>>(std::istream& in, DataStruct& dest)
@@ -160,37 +166,10 @@ namespace dataStruct
 
     std::ostream& operator<<(std::ostream& out, const DataStruct& src)
     {
-        std::ostream::sentry sentry(out);
-        if (!sentry)
-        {
-            return out;
-        }
-        iofmtguard fmtguard(out);
-        out << "(";
-        out << ":key1 " << std::fixed << std::setprecision(1) << src.key1 << "d";
-        out << ":key2 " << "(:N " << src.key2.first << ":D " << src.key2.second << ":)";
-        out << ":key3 \"" << src.key3 << "\":";
-        out << ")";
+        recordSchema< DataStruct >().write(out, src);
         return out;
     }
 
-    iofmtguard::iofmtguard(std::basic_ios< char >& s) :
-        s_(s),
-        width_(s.width()),
-        fill_(s.fill()),
-        precision_(s.precision()),
-        fmt_(s.flags())
-    {
-    }
-
-    iofmtguard::~iofmtguard()
-    {
-        s_.width(width_);
-        s_.fill(fill_);
-        s_.precision(precision_);
-        s_.flags(fmt_);
-    }
-
     std::istream& nextCharAsLowercase(std::istream& is)
     {
         is.iword(NEXT_CHAR_AS_LOWERCASE_DATA_ID) = 1;
@@ -0,0 +1,98 @@
+#include "LiveStore.h"
+
+#include <algorithm>
+
+#include "Scanner.h"
+#include "SortKey.h"
+
+namespace dataStruct
+{
+    bool LiveStore::EntryOrder::operator()(const Entry& left, const Entry& right) const
+    {
+        const SortKey leftKey = makeSortKey(left.record);
+        const SortKey rightKey = makeSortKey(right.record);
+        if (leftKey < rightKey)
+        {
+            return true;
+        }
+        return !(rightKey < leftKey) && left.sequence < right.sequence;
+    }
+
+    LiveStore::LiveStore(common::ParseTelemetry* telemetry) :
+        telemetry_(telemetry),
+        skipping_(false),
+        count_(0)
+    {
+    }
+
+    void LiveStore::feed(const std::string& text)
+    {
+        pending_ += text;
+        scan(false);
+    }
+
+    void LiveStore::finish()
+    {
+        scan(true);
+    }
+
+    void LiveStore::printSnapshot(std::ostream& out)
+    {
+        records_.forEach([&out](const Entry& entry)
+        {
+            out << entry.record << '\n';
+        });
+        added_.clear();
+    }
+
+    void LiveStore::printDiff(std::ostream& out)
+    {
+        std::sort(added_.begin(), added_.end(), EntryOrder());
+        for (const Entry& entry : added_)
+        {
+            out << '+' << records_.rank(entry) << ' ' << entry.record << '\n';
+        }
+        added_.clear();
+    }
+
+    // Adds the complete records of the pending text. Unless the text is
+    // complete, an attempt that runs into its end is kept for the next feed,
+    // like StreamReader keeps it for the next block, and so is an unfinished
+    // skip after a rejected record.
+    void LiveStore::scan(bool complete)
+    {
+        const char* end = pending_.data() + pending_.size();
+        Scanner scanner(pending_.data(), end, telemetry_);
+        if (skipping_)
+        {
+            scanner.skip();
+        }
+        skipping_ = skipping_ && scanner.position() == end;
+        std::size_t start = 0;
+        DataStruct record;
+        while (true)
+        {
+            start = scanner.position() - pending_.data();
+            Scanner::Status status = scanner.next(record);
+            if (status == Scanner::RECORD)
+            {
+                Entry entry{ record, count_++ };
+                records_.insert(entry);
+                added_.push_back(entry);
+            }
+            else if (status == Scanner::REJECTED)
+            {
+                skipping_ = scanner.position() == end;
+            }
+            else if (status == Scanner::END)
+            {
+                if (complete)
+                {
+                    scanner.reportEnd(pending_.data() + start);
+                }
+                break;
+            }
+        }
+        pending_.erase(0, complete ? pending_.size() : start);
+    }
+}
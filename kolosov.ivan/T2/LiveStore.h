@@ -0,0 +1,60 @@
+#ifndef LIVE_STORE_H
+#define LIVE_STORE_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BPlusTree.h"
+#include "DataStruct.h"
+#include "ParseTelemetry.h"
+
+namespace dataStruct
+{
+    // The records of an input that is still growing, kept in sorted order.
+    // Text is fed as it arrives; a record is added once it is complete, and
+    // the records are the same as when the whole text is read at once.
+    class LiveStore
+    {
+    public:
+        // Rejected records are reported to telemetry, if given.
+        explicit LiveStore(common::ParseTelemetry* telemetry = nullptr);
+
+        void feed(const std::string& text);
+        // No more text will come.
+        void finish();
+
+        // Every record in order.
+        void printSnapshot(std::ostream& out);
+        // The records added since the last print, in order, each as
+        // "+position record": inserting them one by one at those positions
+        // into the previous snapshot gives the current one.
+        void printDiff(std::ostream& out);
+
+    private:
+        // Records that compare equal are kept in arrival order.
+        struct Entry
+        {
+            DataStruct record;
+            std::uint64_t sequence;
+        };
+
+        struct EntryOrder
+        {
+            bool operator()(const Entry& left, const Entry& right) const;
+        };
+
+        common::ParseTelemetry* telemetry_;
+        std::string pending_;
+        // The last rejected record's skip ran into the end of the pending text.
+        bool skipping_;
+        std::uint64_t count_;
+        common::BPlusTree< Entry, EntryOrder > records_;
+        std::vector< Entry > added_;
+
+        void scan(bool complete);
+    };
+}
+
+#endif
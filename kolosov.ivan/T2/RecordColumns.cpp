@@ -0,0 +1,149 @@
+#include "RecordColumns.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "InputBuffer.h"
+#include "ParallelScan.h"
+#include "RadixSort.h"
+#include "Scanner.h"
+#include "SortKey.h"
+
+namespace dataStruct
+{
+    RecordColumns::RecordColumns() :
+        offsets_(1, 0)
+    {
+    }
+
+    void RecordColumns::push_back(const DataStruct& record)
+    {
+        key1_.push_back(record.key1);
+        numerators_.push_back(record.key2.first);
+        denominators_.push_back(record.key2.second);
+        pushText(record.key3.data(), record.key3.size());
+    }
+
+    void RecordColumns::push_back(const RecordView& record)
+    {
+        key1_.push_back(record.key1);
+        numerators_.push_back(record.key2.first);
+        denominators_.push_back(record.key2.second);
+        pushText(record.key3.data, record.key3.size);
+    }
+
+    void RecordColumns::append(const std::vector< RecordView >& records)
+    {
+        const std::size_t first = size();
+        const std::size_t count = records.size();
+        std::size_t text = text_.size();
+        for (const RecordView& record : records)
+        {
+            text += record.key3.size;
+        }
+        key1_.resize(first + count);
+        numerators_.resize(first + count);
+        denominators_.resize(first + count);
+        offsets_.resize(first + count + 1);
+        text_.resize(text);
+
+        const RecordView* record = records.data();
+        double* key1 = key1_.data() + first;
+        long long* numerator = numerators_.data() + first;
+        unsigned long long* denominator = denominators_.data() + first;
+        std::size_t* offset = offsets_.data() + first;
+        char* heap = text_.data();
+        for (std::size_t i = 0; i < count; ++i, ++record)
+        {
+            key1[i] = record->key1;
+            numerator[i] = record->key2.first;
+            denominator[i] = record->key2.second;
+            std::memcpy(heap + offset[i], record->key3.data, record->key3.size);
+            offset[i + 1] = offset[i] + record->key3.size;
+        }
+    }
+
+    std::size_t RecordColumns::size() const
+    {
+        return key1_.size();
+    }
+
+    RecordView RecordColumns::operator[](std::size_t index) const
+    {
+        const StringRef key3{ text_.data() + offsets_[index],
+            offsets_[index + 1] - offsets_[index] };
+        return RecordView{ key1_[index], { numerators_[index], denominators_[index] }, key3 };
+    }
+
+    std::vector< std::uint32_t > RecordColumns::sortedOrder() const
+    {
+        std::vector< common::RadixItem< 1 > > items(size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            items[i].key[0] = common::orderedBits(key1_[i]);
+            items[i].index = static_cast< std::uint32_t >(i);
+        }
+        common::radixSort(items);
+
+        std::vector< std::uint32_t > order(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            order[i] = items[i].index;
+        }
+        std::size_t first = 0;
+        for (std::size_t i = 1; i <= items.size(); ++i)
+        {
+            if (i == items.size() || items[i].key[0] != items[first].key[0])
+            {
+                if (i - first > 1)
+                {
+                    sortTies(order.data() + first, order.data() + i);
+                }
+                first = i;
+            }
+        }
+        return order;
+    }
+
+    void RecordColumns::pushText(const char* data, std::size_t size)
+    {
+        text_.insert(text_.end(), data, data + size);
+        offsets_.push_back(text_.size());
+    }
+
+    void RecordColumns::sortTies(std::uint32_t* first, std::uint32_t* last) const
+    {
+        std::stable_sort(first, last, [this](std::uint32_t left, std::uint32_t right)
+        {
+            return makeSortKey((*this)[left]) < makeSortKey((*this)[right]);
+        });
+    }
+
+    RecordColumns readColumns(int fd, common::ParseTelemetry* telemetry)
+    {
+        const common::InputBuffer input(fd);
+        const char* end = input.data() + input.size();
+        RecordColumns columns;
+        if (!telemetry)
+        {
+            columns.append(common::parallelScan< RecordView, Scanner >(input.data(), end));
+            return columns;
+        }
+        Scanner scanner(input.data(), end, telemetry);
+        RecordView record{};
+        while (true)
+        {
+            const char* start = scanner.position();
+            Scanner::Status status = scanner.next(record);
+            if (status == Scanner::RECORD)
+            {
+                columns.push_back(record);
+            }
+            else if (status == Scanner::END)
+            {
+                scanner.reportEnd(start);
+                return columns;
+            }
+        }
+    }
+}
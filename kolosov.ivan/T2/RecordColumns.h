@@ -0,0 +1,59 @@
+#ifndef RECORD_COLUMNS_H
+#define RECORD_COLUMNS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "DataStruct.h"
+#include "ParseTelemetry.h"
+#include "RecordView.h"
+
+namespace dataStruct
+{
+    // Records stored field by field: key1, the numerators and the
+    // denominators of key2 each in an array of their own, and the key3 texts
+    // one after another in a single heap. Sorting reads only the key1 column
+    // and looks at the others just for records with the same key1, so the
+    // columns it walks are a fraction of the size of the records. A record
+    // is put together again when it is printed.
+    class RecordColumns
+    {
+    public:
+        RecordColumns();
+
+        void push_back(const DataStruct& record);
+        void push_back(const RecordView& record);
+        void append(const std::vector< RecordView >& records);
+
+        std::size_t size() const;
+        // The record's key3 refers into the heap, which moves as more
+        // records are added.
+        RecordView operator[](std::size_t index) const;
+
+        // Positions of the records in comparator order, as sorting
+        // makeSortKey(record) stably would give them.
+        std::vector< std::uint32_t > sortedOrder() const;
+
+    private:
+        std::vector< double > key1_;
+        std::vector< long long > numerators_;
+        std::vector< unsigned long long > denominators_;
+        // key3 of record i is text_[offsets_[i], offsets_[i + 1]).
+        std::vector< std::size_t > offsets_;
+        std::vector< char > text_;
+
+        void pushText(const char* data, std::size_t size);
+        // Sorts the positions in [first, last), whose records have the same
+        // key1, by the remaining fields.
+        void sortTies(std::uint32_t* first, std::uint32_t* last) const;
+    };
+
+    // All records of the input of a file descriptor, which is read directly,
+    // so nothing of it may have been read through a stream before. A file is
+    // mapped rather than read, and large inputs are scanned in chunks on
+    // several threads, unless rejected records are reported to a telemetry:
+    // then the input is scanned in one pass, so each is reported once.
+    RecordColumns readColumns(int fd, common::ParseTelemetry* telemetry = nullptr);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include "RecordView.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Schema.h"
+
+namespace dataStruct
+{
+    bool operator<(const StringRef& left, const StringRef& right)
+    {
+        int order = std::memcmp(left.data, right.data, std::min(left.size, right.size));
+        return order != 0 ? order < 0 : left.size < right.size;
+    }
+
+    std::ostream& operator<<(std::ostream& out, const StringRef& src)
+    {
+        return out.write(src.data, src.size);
+    }
+
+    void assignText(StringRef& dest, const char* begin, const char* end)
+    {
+        dest = StringRef{ begin, static_cast<std::size_t>(end - begin) };
+    }
+
+    std::ostream& operator<<(std::ostream& out, const RecordView& src)
+    {
+        recordSchema< RecordView >().write(out, src);
+        return out;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef RECORD_VIEW_H
+#define RECORD_VIEW_H
+
+#include <iostream>
+
+#include "DataStruct.h"
+
+namespace dataStruct
+{
+    // Characters stored elsewhere; C++14 has no std::string_view.
+    struct StringRef
+    {
+        const char* data;
+        std::size_t size;
+    };
+
+    // Same order as std::string.
+    bool operator<(const StringRef& left, const StringRef& right);
+    std::ostream& operator<<(std::ostream& out, const StringRef& src);
+    void assignText(StringRef& dest, const char* begin, const char* end);
+
+    // DataStruct whose key3 points into the buffer the record was scanned
+    // from. A quoted key3 needs no unescaping, so it can stay where it is.
+    struct RecordView
+    {
+        double key1;
+        std::pair<long long, unsigned long long> key2;
+        StringRef key3;
+    };
+
+    // Prints the record exactly as the DataStruct with the same keys.
+    std::ostream& operator<<(std::ostream& out, const RecordView& src);
+}
+
+#endif
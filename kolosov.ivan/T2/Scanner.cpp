@@ -0,0 +1,137 @@
+#include "Scanner.h"
+
+#include <cstring>
+
+#include "Schema.h"
+
+namespace dataStruct
+{
+    Scanner::Scanner(const char* begin, const char* end, common::ParseTelemetry* telemetry) :
+        cursor_(begin, end),
+        end_(end),
+        telemetry_(telemetry)
+    {
+    }
+
+    Scanner::Status Scanner::next(RecordView& dest)
+    {
+        const char* start = cursor_.position();
+        if (recordSchema< RecordView >().read(cursor_, dest))
+        {
+            return RECORD;
+        }
+        if (cursor_.eof())
+        {
+            return END;
+        }
+        if (telemetry_)
+        {
+            report(start, cursor_.error(), cursor_.position());
+        }
+        skip();
+        return REJECTED;
+    }
+
+    Scanner::Status Scanner::next(DataStruct& dest)
+    {
+        RecordView view{};
+        Status status = next(view);
+        if (status == RECORD)
+        {
+            dest.key1 = view.key1;
+            dest.key2 = view.key2;
+            dest.key3.assign(view.key3.data, view.key3.size);
+        }
+        return status;
+    }
+
+    const char* Scanner::position() const
+    {
+        return cursor_.position();
+    }
+
+    void Scanner::skip()
+    {
+        // Every attempt before the next '(' would fail at its first
+        // character, so they are skipped all at once.
+        cursor_.skipTo('(');
+    }
+
+    void Scanner::reportEnd(const char* start) const
+    {
+        if (telemetry_)
+        {
+            report(start, common::ParseError::END_OF_INPUT, end_);
+        }
+    }
+
+    void Scanner::report(const char* start, common::ParseError error, const char* failure) const
+    {
+        while (start != end_ && common::isSpace(*start))
+        {
+            ++start;
+        }
+        if (start != end_)
+        {
+            telemetry_->reject(error, start, failure, end_);
+        }
+    }
+
+    StreamReader::StreamReader(std::istream& in, std::size_t blockSize,
+        common::ParseTelemetry* telemetry) :
+        in_(in),
+        blockSize_(blockSize),
+        size_(0),
+        complete_(false),
+        skipping_(false),
+        telemetry_(telemetry),
+        scanner_(buffer_.data(), buffer_.data())
+    {
+    }
+
+    bool StreamReader::next(DataStruct& dest)
+    {
+        while (true)
+        {
+            std::size_t start = scanner_.position() - buffer_.data();
+            Scanner::Status status = scanner_.next(dest);
+            if (status == Scanner::RECORD)
+            {
+                return true;
+            }
+            if (status == Scanner::REJECTED)
+            {
+                skipping_ = scanner_.position() == buffer_.data() + size_;
+            }
+            else if (status == Scanner::END)
+            {
+                if (complete_)
+                {
+                    scanner_.reportEnd(buffer_.data() + start);
+                    return false;
+                }
+                refill(start);
+            }
+        }
+    }
+
+    // Drops the bytes before keep and appends the next block of input.
+    void StreamReader::refill(std::size_t keep)
+    {
+        std::size_t kept = size_ - keep;
+        std::memmove(buffer_.data(), buffer_.data() + keep, kept);
+        if (buffer_.size() < kept + blockSize_)
+        {
+            buffer_.resize(kept + blockSize_);
+        }
+        in_.read(buffer_.data() + kept, blockSize_);
+        size_ = kept + in_.gcount();
+        complete_ = !in_;
+        scanner_ = Scanner(buffer_.data(), buffer_.data() + size_, telemetry_);
+        if (skipping_)
+        {
+            scanner_.skip();
+            skipping_ = scanner_.position() == buffer_.data() + size_;
+        }
+    }
+}
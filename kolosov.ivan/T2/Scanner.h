@@ -0,0 +1,80 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <istream>
+#include <vector>
+
+#include "DataStruct.h"
+#include "ParseTelemetry.h"
+#include "RecordView.h"
+#include "TextCursor.h"
+
+namespace dataStruct
+{
+    // Single-pass reader of DataStruct records from a contiguous buffer.
+    // It accepts exactly the records operator>> accepts on std::cin and, after
+    // a rejected record, resumes at the first '(' from the character where the
+    // stream would have stopped, so it keeps the same records as main's
+    // clear-and-retry loop, which fails on every other character. Given a
+    // telemetry, it reports every record it rejects there.
+    class Scanner
+    {
+    public:
+        enum Status
+        {
+            RECORD,
+            REJECTED,
+            END
+        };
+
+        Scanner(const char* begin, const char* end,
+            common::ParseTelemetry* telemetry = nullptr);
+
+        // A view's key3 refers into the scanned buffer.
+        Status next(RecordView& dest);
+        Status next(DataStruct& dest);
+        const char* position() const;
+        // Skips to the next '(' without reporting: the rest of a rejected
+        // record whose skip ran into the end of the previous buffer.
+        void skip();
+        // For END when no input follows the buffer: reports the attempt that
+        // started at start, unless it was only whitespace, as cut off by the
+        // end of the input.
+        void reportEnd(const char* start) const;
+
+    private:
+        common::TextCursor cursor_;
+        const char* end_;
+        common::ParseTelemetry* telemetry_;
+
+        void report(const char* start, common::ParseError error, const char* failure) const;
+    };
+
+    // Reads records from a stream one block at a time. An attempt that runs
+    // into the end of the block is repeated once more input has been read,
+    // and a skip after a rejected record goes on into the next block, so the
+    // records and rejects are the same as when scanning the whole input at once.
+    class StreamReader
+    {
+    public:
+        explicit StreamReader(std::istream& in, std::size_t blockSize = 1 << 20,
+            common::ParseTelemetry* telemetry = nullptr);
+
+        // False once the input is exhausted.
+        bool next(DataStruct& dest);
+
+    private:
+        std::istream& in_;
+        std::size_t blockSize_;
+        std::vector< char > buffer_;
+        std::size_t size_;
+        bool complete_;
+        bool skipping_;
+        common::ParseTelemetry* telemetry_;
+        Scanner scanner_;
+
+        void refill(std::size_t keep);
+    };
+}
+
+#endif
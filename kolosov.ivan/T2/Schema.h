@@ -0,0 +1,19 @@
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include "RecordSchema.h"
+
+namespace dataStruct
+{
+    // The text form of DataStruct and RecordView, which share their keys.
+    template < typename Record >
+    constexpr auto recordSchema()
+    {
+        return common::makeSchema(
+            common::field(":key1", &Record::key1, common::DoubleLiteral< common::Chars< 'd' > >()),
+            common::field(":key2", &Record::key2, common::RationalLiteral()),
+            common::field(":key3", &Record::key3, common::QuotedString()));
+    }
+}
+
+#endif
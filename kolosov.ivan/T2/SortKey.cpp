@@ -0,0 +1,52 @@
+#include "SortKey.h"
+
+#include "RadixSort.h"
+
+namespace dataStruct
+{
+    namespace
+    {
+        // Sign of left.numerator / left.denominator - right.numerator / right.denominator.
+        int compareRatios(const SortKey& left, const SortKey& right)
+        {
+            __int128 lhs = static_cast<__int128>(left.numerator) * right.denominator;
+            __int128 rhs = static_cast<__int128>(right.numerator) * left.denominator;
+            return (lhs > rhs) - (lhs < rhs);
+        }
+    }
+
+    SortKey makeSortKey(const DataStruct& record, std::size_t index)
+    {
+        StringRef key3{ record.key3.data(), record.key3.size() };
+        return SortKey{ common::orderedBits(record.key1), record.key2.first, record.key2.second,
+            key3, index };
+    }
+
+    SortKey makeSortKey(const RecordView& record, std::size_t index)
+    {
+        return SortKey{ common::orderedBits(record.key1), record.key2.first, record.key2.second,
+            record.key3, index };
+    }
+
+    bool operator<(const SortKey& left, const SortKey& right)
+    {
+        if (left.key1 != right.key1)
+        {
+            return left.key1 < right.key1;
+        }
+        int ratio = compareRatios(left, right);
+        if (ratio != 0)
+        {
+            return ratio < 0;
+        }
+        if (left.numerator != right.numerator)
+        {
+            return left.numerator < right.numerator;
+        }
+        if (left.denominator != right.denominator)
+        {
+            return left.denominator < right.denominator;
+        }
+        return left.key3 < right.key3;
+    }
+}
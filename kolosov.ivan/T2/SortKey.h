@@ -0,0 +1,35 @@
+#ifndef SORT_KEY_H
+#define SORT_KEY_H
+
+#include <cstdint>
+
+#include "DataStruct.h"
+#include "RecordView.h"
+
+namespace dataStruct
+{
+    // Fields of a record as comparator looks at them, computed once before
+    // sorting: key1 as an integer with the same order as the double, and the
+    // rational key2 compared by exact 128-bit cross-multiplication, so there is
+    // neither a gcd per comparison nor an overflowing product.
+    struct SortKey
+    {
+        std::uint64_t key1;
+        long long numerator;
+        unsigned long long denominator;
+        StringRef key3;
+        // Position of the record in the sorted collection.
+        std::size_t index;
+    };
+
+    // The key refers to the record's key3, so the record must outlive it.
+    SortKey makeSortKey(const DataStruct& record, std::size_t index = 0);
+    SortKey makeSortKey(const RecordView& record, std::size_t index = 0);
+
+    // Strict weak order refining comparator: records it leaves unordered
+    // (equal key1 and equal rationals written differently, such as 1/2 and 2/4)
+    // are ordered by numerator and denominator, then by key3.
+    bool operator<(const SortKey& left, const SortKey& right);
+}
+
+#endif
@@ -1,41 +1,429 @@
+#include <limits>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "Binary.h"
 #include "DataStruct.h"
+#include "ExternalSort.h"
+#include "LiveStore.h"
+#include "ParseTelemetry.h"
+#include "PhaseStats.h"
+#include "RecordColumns.h"
+#include "Scanner.h"
+#include "SortKey.h"
+#include "TopSelector.h"
 
-int main()
+namespace
 {
-    using dataStruct::DataStruct;
+    // Byte count with an optional K, M or G suffix.
+    std::size_t parseMemory(const std::string& text)
+    {
+        std::size_t end = 0;
+        unsigned long long value = 0;
+        try
+        {
+            value = std::stoull(text, &end);
+        }
+        catch (const std::logic_error&)
+        {
+            throw std::invalid_argument("bad --max-memory value: " + text);
+        }
+        std::string suffix = text.substr(end);
+        int shift = 0;
+        if (suffix == "K" || suffix == "k")
+        {
+            shift = 10;
+        }
+        else if (suffix == "M" || suffix == "m")
+        {
+            shift = 20;
+        }
+        else if (suffix == "G" || suffix == "g")
+        {
+            shift = 30;
+        }
+        else if (!suffix.empty() || text[0] == '-')
+        {
+            throw std::invalid_argument("bad --max-memory value: " + text);
+        }
+        if (value == 0 || value > (std::numeric_limits< std::size_t >::max() >> shift))
+        {
+            throw std::invalid_argument("bad --max-memory value: " + text);
+        }
+        return static_cast< std::size_t >(value) << shift;
+    }
 
-    std::vector< DataStruct > data;
+    // Record count: a plain decimal number.
+    std::size_t parseCount(const std::string& text)
+    {
+        std::size_t end = 0;
+        unsigned long long value = 0;
+        try
+        {
+            value = std::stoull(text, &end);
+        }
+        catch (const std::logic_error&)
+        {
+            throw std::invalid_argument("bad --top value: " + text);
+        }
+        if (end != text.size() || text[0] == '-' || text[0] == '+'
+            || value > std::numeric_limits< std::size_t >::max())
+        {
+            throw std::invalid_argument("bad --top value: " + text);
+        }
+        return static_cast< std::size_t >(value);
+    }
 
-    while (!std::cin.eof())
+    // "text" or "binary", the interchange format of Binary.h.
+    bool parseBinary(const std::string& option, const std::string& text)
     {
-        if (!std::cin)
+        if (text != "text" && text != "binary")
         {
-            std::cin.clear();
+            throw std::invalid_argument("bad " + option + " value: " + text);
         }
-        std::copy
-        (
-            std::istream_iterator< DataStruct >(std::cin),
-            std::istream_iterator< DataStruct >(),
-            std::back_inserter(data)
-        );
-        if (!std::cin)
+        return text == "binary";
+    }
+
+    // Calls f with every record of stdin; text input reports the records it
+    // rejects to telemetry, if given.
+    template < typename F >
+    void readRecords(bool binary, common::ParseTelemetry* telemetry, F f)
+    {
+        dataStruct::DataStruct record;
+        if (binary)
         {
-            std::cin.ignore(100,'\n');
+            dataStruct::readBinaryHeader(stdin);
+            while (dataStruct::readBinary(stdin, record))
+            {
+                f(record);
+            }
+            return;
+        }
+        dataStruct::StreamReader reader(std::cin, 1 << 20, telemetry);
+        while (reader.next(record))
+        {
+            f(record);
         }
     }
 
-    std::sort
-    (
-        data.begin(),
-        data.end(),
-        dataStruct::comparator
-    );
+    // Writes records to stdout, as text lines or as a binary stream.
+    class RecordWriter
+    {
+    public:
+        explicit RecordWriter(bool binary) :
+            binary_(binary)
+        {
+            if (binary_)
+            {
+                dataStruct::writeBinaryHeader(stdout);
+            }
+        }
+
+        template < typename Record >
+        void operator()(const Record& record) const
+        {
+            if (binary_)
+            {
+                dataStruct::writeBinary(stdout, record);
+            }
+            else
+            {
+                std::cout << record << '\n';
+            }
+        }
+
+    private:
+        bool binary_;
+    };
+
+    // What happens to records that are equal in all three keys.
+    enum class Duplicates
+    {
+        KEEP,
+        UNIQUE,
+        COUNT
+    };
+
+    // Passes sorted records on to a RecordWriter. Unless duplicates are kept,
+    // each run of equal records is passed on as its first record, which with
+    // COUNT is printed after the length of the run.
+    template < typename Record >
+    class DuplicateFilter
+    {
+    public:
+        DuplicateFilter(Duplicates duplicates, bool binary) :
+            duplicates_(duplicates),
+            write_(binary),
+            count_(0)
+        {
+        }
+
+        void operator()(const Record& record)
+        {
+            if (duplicates_ == Duplicates::KEEP)
+            {
+                write_(record);
+                return;
+            }
+            if (count_ != 0 && isDuplicate(record))
+            {
+                ++count_;
+                return;
+            }
+            flush();
+            previous_ = record;
+            count_ = 1;
+        }
+
+        // Passes on the last run.
+        void finish()
+        {
+            flush();
+        }
+
+    private:
+        Duplicates duplicates_;
+        RecordWriter write_;
+        Record previous_;
+        std::size_t count_;
 
-    std::copy(
-        std::begin(data),
-        std::end(data),
-        std::ostream_iterator< DataStruct >(std::cout, "\n")
-    );
+        bool isDuplicate(const Record& record) const
+        {
+            const dataStruct::SortKey left = dataStruct::makeSortKey(previous_);
+            const dataStruct::SortKey right = dataStruct::makeSortKey(record);
+            return !(left < right) && !(right < left);
+        }
 
+        void flush()
+        {
+            if (count_ == 0)
+            {
+                return;
+            }
+            if (duplicates_ == Duplicates::COUNT)
+            {
+                std::cout << count_ << ' ';
+            }
+            write_(previous_);
+            count_ = 0;
+        }
+    };
+
+    struct RecordOrder
+    {
+        bool operator()(const dataStruct::DataStruct& left,
+            const dataStruct::DataStruct& right) const
+        {
+            return dataStruct::makeSortKey(left) < dataStruct::makeSortKey(right);
+        }
+    };
+
+    // Sorts with at most about memoryLimit bytes of records in memory at a
+    // time, spilling sorted runs to temporary files.
+    void sortExternally(std::size_t memoryLimit, Duplicates duplicates, bool binaryInput,
+        bool binaryOutput, common::ParseTelemetry* telemetry)
+    {
+        using dataStruct::DataStruct;
+        common::ExternalSorter< DataStruct, dataStruct::BinaryCodec, RecordOrder >
+            sorter(memoryLimit, RecordOrder());
+        readRecords(binaryInput, telemetry, [&sorter](const DataStruct& record)
+        {
+            sorter.push(record);
+        });
+        DuplicateFilter< DataStruct > filter(duplicates, binaryOutput);
+        sorter.finish([&filter](const DataStruct& record)
+        {
+            filter(record);
+        });
+        filter.finish();
+    }
+
+    // Prints the first count records of the sorted output, holding no more
+    // than count records in memory.
+    void printTop(std::size_t count, bool binaryInput, bool binaryOutput,
+        common::ParseTelemetry* telemetry)
+    {
+        using dataStruct::DataStruct;
+        common::TopSelector< DataStruct, RecordOrder > top(count, RecordOrder());
+        readRecords(binaryInput, telemetry, [&top](const DataStruct& record)
+        {
+            top.push(record);
+        });
+        RecordWriter write(binaryOutput);
+        for (const DataStruct& sorted : top.finish())
+        {
+            write(sorted);
+        }
+    }
+
+    void sortInMemory(Duplicates duplicates, bool binaryInput, bool binaryOutput,
+        common::ParseTelemetry* telemetry, common::PhaseStats& stats)
+    {
+        stats.start("parse");
+        dataStruct::RecordColumns columns;
+        if (binaryInput)
+        {
+            readRecords(true, nullptr, [&columns](const dataStruct::DataStruct& record)
+            {
+                columns.push_back(record);
+            });
+        }
+        else
+        {
+            columns = dataStruct::readColumns(STDIN_FILENO, telemetry);
+        }
+        stats.start("sort");
+        const std::vector< std::uint32_t > order = columns.sortedOrder();
+        stats.start("print");
+        DuplicateFilter< dataStruct::RecordView > filter(duplicates, binaryOutput);
+        for (std::uint32_t index : order)
+        {
+            filter(columns[index]);
+        }
+        filter.finish();
+        std::cout.flush();
+        std::fflush(stdout);
+    }
+
+    // Keeps the records sorted while they arrive. A line "#snapshot" prints
+    // all of them and "#diff" the ones added since the last print, either
+    // followed by a line "#end"; every other line is record text.
+    void runLive(common::ParseTelemetry* telemetry)
+    {
+        dataStruct::LiveStore store(telemetry);
+        std::string line;
+        while (std::getline(std::cin, line))
+        {
+            if (line == "#snapshot" || line == "#diff")
+            {
+                if (line == "#snapshot")
+                {
+                    store.printSnapshot(std::cout);
+                }
+                else
+                {
+                    store.printDiff(std::cout);
+                }
+                std::cout << "#end" << std::endl;
+            }
+            else
+            {
+                store.feed(line + '\n');
+            }
+        }
+        store.finish();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::ios::sync_with_stdio(false);
+    common::PhaseStats stats(argc, argv);
+    std::size_t memoryLimit = 0;
+    bool top = false;
+    std::size_t topCount = 0;
+    bool live = false;
+    bool binaryInput = false;
+    bool binaryOutput = false;
+    Duplicates duplicates = Duplicates::KEEP;
+    common::ParseTelemetry telemetry;
+    common::ParseTelemetry* rejects = nullptr;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--max-memory" && i + 1 < argc)
+            {
+                memoryLimit = parseMemory(argv[++i]);
+            }
+            else if (arg == "--top" && i + 1 < argc)
+            {
+                top = true;
+                topCount = parseCount(argv[++i]);
+            }
+            else if (arg == "--stats")
+            {
+                // Taken by PhaseStats.
+            }
+            else if (arg == "--rejects")
+            {
+                rejects = &telemetry;
+            }
+            else if (arg == "--live")
+            {
+                live = true;
+            }
+            else if (arg == "--unique" || arg == "--count-by-key")
+            {
+                if (duplicates != Duplicates::KEEP)
+                {
+                    throw std::invalid_argument("--unique and --count-by-key cannot be combined");
+                }
+                duplicates = arg == "--unique" ? Duplicates::UNIQUE : Duplicates::COUNT;
+            }
+            else if (arg == "--input-format" && i + 1 < argc)
+            {
+                binaryInput = parseBinary(arg, argv[++i]);
+            }
+            else if (arg == "--output-format" && i + 1 < argc)
+            {
+                binaryOutput = parseBinary(arg, argv[++i]);
+            }
+            else
+            {
+                throw std::invalid_argument("unknown argument: " + arg);
+            }
+        }
+        if (top + live + (memoryLimit != 0) > 1)
+        {
+            throw std::invalid_argument("--top, --max-memory and --live cannot be combined");
+        }
+        if (live && (binaryInput || binaryOutput))
+        {
+            throw std::invalid_argument("--live reads and writes text only");
+        }
+        if ((top || live) && duplicates != Duplicates::KEEP)
+        {
+            throw std::invalid_argument("--top and --live keep duplicates");
+        }
+        if (duplicates == Duplicates::COUNT && binaryOutput)
+        {
+            throw std::invalid_argument("--count-by-key writes text only");
+        }
+        if (live)
+        {
+            runLive(rejects);
+        }
+        else if (top)
+        {
+            printTop(topCount, binaryInput, binaryOutput, rejects);
+        }
+        else if (memoryLimit != 0)
+        {
+            sortExternally(memoryLimit, duplicates, binaryInput, binaryOutput, rejects);
+        }
+        else
+        {
+            sortInMemory(duplicates, binaryInput, binaryOutput, rejects, stats);
+            stats.finish();
+        }
+        // A full disk or a closed pipe must not pass for a complete output.
+        std::cout.flush();
+        if (!std::cout || std::fflush(stdout) != 0 || std::ferror(stdout))
+        {
+            throw std::runtime_error("could not write the output");
+        }
+        if (rejects)
+        {
+            rejects->report(std::cerr);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << '\n';
+        return 1;
+    }
     return 0;
 }
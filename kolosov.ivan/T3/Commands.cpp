@@ -1,4 +1,5 @@
 #include <string>
+#include <sstream>
 #include <iomanip>
 #include <numeric>
 #include <iterator>
@@ -300,3 +301,18 @@ void cmd::rightshapes(const std::vector< shapes::Polygon >& shapes, std::istream
 
     out << count_if(shapes.begin(), shapes.end(), subcmd::hasRightAngle);
 }
+
+void cmd::stats(const common::StatsRegistry& registry, std::istream& in, std::ostream& out)
+{
+    if (in.peek() != '\n')
+    {
+        throw std::invalid_argument("No required param");
+    }
+
+    // The report ends in a line break, which the command loop writes.
+    std::ostringstream report;
+    registry.print(report);
+    std::string text = report.str();
+    text.pop_back();
+    out << text;
+}
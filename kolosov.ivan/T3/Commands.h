@@ -8,6 +8,7 @@
 
 #include "Shapes.h"
 #include "Subcommands.h"
+#include "CommandStats.h"
 
 namespace cmd
 {
@@ -17,6 +18,7 @@ namespace cmd
     void count(const std::vector< shapes::Polygon >& shapes, std::istream& in, std::ostream& out);
     void inframe(const std::vector< shapes::Polygon >& shapes, std::istream& in, std::ostream& out);
     void rightshapes(const std::vector< shapes::Polygon >& shapes, std::istream& in, std::ostream& out);
+    void stats(const common::StatsRegistry& registry, std::istream& in, std::ostream& out);
 }
 
 #endif
@@ -8,21 +8,22 @@
 #include <exception>
 
 #include "Shapes.h"
+#include "Trace.h"
 
 namespace shapes
 {
-    inline std::vector< Polygon > fillVectorOfShapes(std::string filename)
+    inline std::vector< Polygon > fillVectorOfShapes(std::istream& file)
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
-        {
-            throw std::invalid_argument("Error occurred while opening file. Check that such a file exists");
-        }
-
         std::vector< Polygon > shapes;
 
         while (!file.eof())
         {
+            std::string from;
+            if (common::Tracer::instance().enabled())
+            {
+                from = "from shape " + std::to_string(shapes.size());
+            }
+            common::TraceScope scope("parse chunk", from);
             std::copy
             (
                 std::istream_iterator< Polygon >(file),
@@ -36,9 +37,22 @@ namespace shapes
             }
         }
 
-        file.close();
         return shapes;
     }
+
+    inline std::vector< Polygon > fillVectorOfShapes(std::string filename)
+    {
+        std::ifstream file;
+        {
+            common::TraceScope scope("open file", filename);
+            file.open(filename);
+        }
+        if (!file.is_open())
+        {
+            throw std::invalid_argument("Error occurred while opening file. Check that such a file exists");
+        }
+        return fillVectorOfShapes(file);
+    }
 }
 
 #endif
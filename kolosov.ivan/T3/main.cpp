@@ -1,21 +1,47 @@
 #include "Commands.h"
 #include "FillVectorOfShapes.h"
 #include "IOFmtguard.h"
+#include "CommandStats.h"
+#include "Trace.h"
 
 int main(int argc, char* argv[])
 {
     std::string filename;
-    if (argc != 2)
+    bool printStats = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--stats")
+        {
+            printStats = true;
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            common::Tracer::instance().enable(argv[++i]);
+        }
+        else if (filename.empty())
+        {
+            filename = arg;
+        }
+        else
+        {
+            filename.clear();
+            break;
+        }
+    }
+    if (filename.empty())
     {
         std::cout << "ERROR: expected filename as only command-line argument\n";
         return -1;
     }
-        filename = argv[1];
 
+    common::StatsRegistry registry;
     std::vector<shapes::Polygon> shapes;
     try
     {
+        common::Stopwatch loadTime;
         shapes = shapes::fillVectorOfShapes(filename);
+        registry.recordPhase("load", loadTime.elapsed());
     }
     catch (std::invalid_argument& ex)
     {
@@ -30,24 +56,55 @@ int main(int argc, char* argv[])
     cmds["COUNT"] = std::bind(cmd::count, std::cref(shapes), std::placeholders::_1, std::placeholders::_2);
     cmds["INFRAME"] = std::bind(cmd::inframe, std::cref(shapes), std::placeholders::_1, std::placeholders::_2);
     cmds["RIGHTSHAPES"] = std::bind(cmd::rightshapes, std::cref(shapes), std::placeholders::_1, std::placeholders::_2);
+    cmds["STATS"] = std::bind(cmd::stats, std::cref(registry), std::placeholders::_1,
+        std::placeholders::_2);
 
     iofmtguard ofmtguard(std::cout);
     std::cout << std::fixed << std::setprecision(1);
     std::string command = "";
     while (std::cin >> command)
     {
+        common::Stopwatch commandTime;
+        auto handler = cmds.find(command);
+        bool failed = false;
+        bool lineConsumed = common::Tracer::instance().enabled();
         try
         {
-            cmds.at(command)(std::cin, std::cout);
+            if (lineConsumed)
+            {
+                std::string args;
+                std::getline(std::cin, args);
+                std::istringstream line(std::cin.eof() ? args : args + '\n');
+                common::TraceScope scope(command.c_str(), args);
+                cmds.at(command)(line, std::cout);
+            }
+            else
+            {
+                cmds.at(command)(std::cin, std::cout);
+            }
             std::cout << '\n';
         }
         catch (...)
         {
+            failed = true;
             std::cout << "<INVALID COMMAND>\n";
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+            if (!lineConsumed)
+            {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+            }
         }
+        std::string name = handler != cmds.end() ? command : "UNKNOWN";
+        registry.recordCommand(name, commandTime.elapsed(), failed);
     }
 
+    if (common::Tracer::instance().enabled() && !common::Tracer::instance().dump())
+    {
+        std::cerr << "ERROR: could not write trace\n";
+    }
+    if (printStats)
+    {
+        registry.print(std::cerr);
+    }
     return 0;
 }
@@ -1,4 +1,3 @@
-#pragma once
 #ifndef DATASTRUCT_H
 #define DATASTRUCT_H
 
@@ -4,10 +4,15 @@
 #include <iterator>
 #include <iostream>
 
-int main()
+#include "PhaseStats.h"
+#include "RadixSort.h"
+
+int main(int argc, char* argv[])
 {
     using nspace::DataStruct;
 
+    common::PhaseStats stats(argc, argv);
+    stats.start("parse");
     std::vector<DataStruct> data;
     std::copy(
         std::istream_iterator<DataStruct>(std::cin),
@@ -15,33 +20,29 @@ int main()
         std::back_inserter(data)
     );
 
-    std::sort(
-        data.begin(),
-        data.end(),
-        [](const DataStruct& a, const DataStruct& b)
-        {
-            if (a.key1 != b.key1)
-            {
-                return a.key1 < b.key1;
-            }
-            if (a.key2 != b.key2)
-            {
-                return a.key2 < b.key2;
-            }
-            return a.key3.size() < b.key3.size();
-        }
-    );
+    stats.start("sort");
+    // Ordered by key1, key2, then the length of key3.
+    std::vector<common::RadixItem<3>> order(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        order[i] = {
+            { common::orderedBits(data[i].key1), data[i].key2, data[i].key3.size() },
+            static_cast<std::uint32_t>(i)
+        };
+    }
+    common::radixSort(order);
 
-    std::copy(
-        data.begin(),
-        data.end(),
-        std::ostream_iterator<DataStruct>(std::cout, "\n")
-    );
+    stats.start("print");
+    for (const auto& item : order)
+    {
+        std::cout << data[item.index] << "\n";
+    }
 
     std::cout << "good: " << std::cin.good() << ", "
         << "fail: " << std::cin.fail() << ", "
         << "bad: " << std::cin.bad() << ", "
         << "eof: " << std::cin.eof() << std::endl;
+    stats.finish();
 
     return 0;
 }